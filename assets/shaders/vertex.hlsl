@@ -3,15 +3,24 @@ struct WorldBuffer {
     column_major float4x4 proj;
 };
 
-struct ObjectBuffer {
+// 0 on the indirect path, there SV_InstanceID already includes first_instance
+struct DrawBuffer {
+    uint baseInstance;
+};
+
+struct ObjectData {
     column_major float4x4 transform;
 };
 
+StructuredBuffer<ObjectData> objects : register(t0, space0);
+
 ConstantBuffer<WorldBuffer> world : register(b0, space1);
-ConstantBuffer<ObjectBuffer> object : register(b1, space1);
+ConstantBuffer<DrawBuffer> draw : register(b1, space1);
 
+// quantized meshes feed unorm positions in 0..1, their transform already maps that range back onto the mesh bounds
 struct VertInput {
     float3 position : POSITION;
+    uint instance : SV_InstanceID;
 };
 
 struct VertOutput {
@@ -19,6 +28,8 @@ struct VertOutput {
 };
 
 VertOutput vertex(VertInput input) {
+    ObjectData object = objects[draw.baseInstance + input.instance];
+
     VertOutput output;
     output.position = mul(world.proj, mul(world.view, mul(object.transform, float4(input.position, -1.0))));
     return output;
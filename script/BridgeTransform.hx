@@ -0,0 +1,30 @@
+package;
+
+// a bound transform seen through the bridge arrays, only an int at runtime.
+// setting Position or Rotation writes floats into native memory, no boxing and no native call
+abstract BridgeTransform(Int) {
+    public var Position(get, set): Vec3;
+    public var Rotation(get, set): Quat;
+
+    public inline function new(slot: Int) {
+        this = slot;
+    }
+
+    inline function get_Position(): Vec3 {
+        return Vec3.Load(ScriptBridge.positions, this);
+    }
+
+    inline function set_Position(value: Vec3): Vec3 {
+        value.Store(ScriptBridge.positions, this);
+        return value;
+    }
+
+    inline function get_Rotation(): Quat {
+        return Quat.Load(ScriptBridge.rotations, this);
+    }
+
+    inline function set_Rotation(value: Quat): Quat {
+        value.Store(ScriptBridge.rotations, this);
+        return value;
+    }
+}
@@ -0,0 +1,38 @@
+package;
+
+import me.game.Component;
+
+// every live component of one type, updated by a single call from native each frame.
+// slots index the native transform arrays, so the update writes positions without going through Transform
+class ComponentBatch<T: Component> {
+    public var components(default, null): Array<T> = [];
+    public var slots(default, null): Array<Int> = [];
+
+    public function new(name: String, update: ComponentBatch<T>->Void) {
+        ScriptBridge.RegisterBatch(name, () -> {
+            ScriptBridge.Refresh();
+            update(this);
+        });
+    }
+
+    public inline function Transform(index: Int): BridgeTransform {
+        return new BridgeTransform(slots[index]);
+    }
+
+    public function Add(component: T): Void {
+        components.push(component);
+        slots.push(ScriptBridge.BindTransform(@:privateAccess component.GameObject.pointer));
+    }
+
+    public function Remove(component: T): Void {
+        var index = components.indexOf(component);
+        if (index < 0) return;
+
+        ScriptBridge.UnbindTransform(slots[index]);
+        var last = components.length - 1;
+        components[index] = components[last];
+        slots[index] = slots[last];
+        components.pop();
+        slots.pop();
+    }
+}
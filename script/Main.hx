@@ -5,5 +5,6 @@ import me.Log;
 class Main {
     public static function main():Void {
         Log.Info("HL setup.");
+        ScriptBridge.RegisterCommand("Benchmark Script Math", ScriptBenchmark.Run);
     }
 }
\ No newline at end of file
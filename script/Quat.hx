@@ -0,0 +1,48 @@
+package;
+
+import hl.BytesAccess;
+
+// rotation in xyzw, inline the same way as Vec3
+final class Quat {
+    public var x: Float;
+    public var y: Float;
+    public var z: Float;
+    public var w: Float;
+
+    public inline function new(x: Float = 0, y: Float = 0, z: Float = 0, w: Float = 1) {
+        this.x = x;
+        this.y = y;
+        this.z = z;
+        this.w = w;
+    }
+
+    public static inline function Identity(): Quat {
+        return new Quat(0, 0, 0, 1);
+    }
+
+    // axis has to be normalized
+    public static inline function FromAxisAngle(axis: Vec3, radians: Float): Quat {
+        var s = Math.sin(radians * 0.5);
+        return new Quat(axis.x * s, axis.y * s, axis.z * s, Math.cos(radians * 0.5));
+    }
+
+    public inline function Mul(other: Quat): Quat {
+        return new Quat(
+            w * other.x + x * other.w + y * other.z - z * other.y,
+            w * other.y - x * other.z + y * other.w + z * other.x,
+            w * other.z + x * other.y - y * other.x + z * other.w,
+            w * other.w - x * other.x - y * other.y - z * other.z
+        );
+    }
+
+    public static inline function Load(array: BytesAccess<Single>, slot: Int): Quat {
+        return new Quat(array[slot * 4], array[slot * 4 + 1], array[slot * 4 + 2], array[slot * 4 + 3]);
+    }
+
+    public inline function Store(array: BytesAccess<Single>, slot: Int): Void {
+        array[slot * 4] = x;
+        array[slot * 4 + 1] = y;
+        array[slot * 4 + 2] = z;
+        array[slot * 4 + 3] = w;
+    }
+}
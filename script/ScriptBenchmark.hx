@@ -0,0 +1,67 @@
+package;
+
+import haxe.Timer;
+import me.Log;
+import me.Time;
+import me.math.Vector3;
+
+// runs TestComponent's update FRAMES times the old way, a Vector3 per component through the Transform setter,
+// then through Vec3 and the bridge. the bridged frame includes the native copies in and out of the arrays, like a real frame.
+// logs gc allocations per frame, time per frame and the pause of the collection that follows
+class ScriptBenchmark {
+    static inline var FRAMES = 240;
+
+    public static function Run(): Void {
+        var batch = TestComponent.batch;
+        if (batch.components.length == 0) {
+            Log.Warn("Script math benchmark needs at least one TestComponent");
+            return;
+        }
+
+        Report("boxed", batch.components.length, Measure(() -> {
+            for (component in batch.components) {
+                var vector = Vector3.Zero();
+                vector.x = Math.sin(Time.Elapsed) * 2;
+                vector.z = Math.cos(Time.Elapsed) * 2;
+                component.Transform.Position = vector;
+            }
+        }));
+
+        Report("bridged", batch.components.length, Measure(() -> {
+            ScriptBridge.Gather();
+            ScriptBridge.Refresh();
+            var position = new Vec3(Math.sin(Time.Elapsed) * 2, 0, Math.cos(Time.Elapsed) * 2);
+            for (i in 0...batch.slots.length) {
+                batch.Transform(i).Position = position;
+            }
+            ScriptBridge.Apply();
+        }));
+    }
+
+    // allocations and bytes per frame, seconds per frame, seconds for the collection after the run
+    static function Measure(frame: Void->Void): Array<Float> {
+        hl.Gc.major();
+        var before = hl.Gc.stats();
+
+        var start = Timer.stamp();
+        for (_ in 0...FRAMES) frame();
+        var seconds = Timer.stamp() - start;
+
+        var after = hl.Gc.stats();
+        var pauseStart = Timer.stamp();
+        hl.Gc.major();
+        var pause = Timer.stamp() - pauseStart;
+
+        return [
+            (after.allocationCount - before.allocationCount) / FRAMES,
+            (after.totalAllocated - before.totalAllocated) / FRAMES,
+            seconds / FRAMES,
+            pause
+        ];
+    }
+
+    static function Report(name: String, components: Int, result: Array<Float>): Void {
+        Log.Info('$name, $components components: ${result[0]} allocations (${Std.int(result[1])} bytes) per frame, '
+            + '${result[2] * 1000} ms per frame, ${result[3] * 1000} ms gc pause');
+    }
+}
@@ -0,0 +1,48 @@
+package;
+
+import hl.BytesAccess;
+import me.internal.Pointer;
+
+// natives from src/script/ScriptNatives.cpp, they live in the executable rather than the engine
+class ScriptBridge {
+    // the transform arrays for the batch that's running, see BridgeTransform
+    public static var positions(default, null): BytesAccess<Single>;
+    public static var rotations(default, null): BytesAccess<Single>;
+
+    // fetches the arrays again, they move when a transform is bound
+    public static function Refresh(): Void {
+        positions = Positions();
+        rotations = Rotations();
+    }
+
+    // update runs once a frame and covers every component of the type
+    @:hlNative("builtin", "script_batch_register")
+    public static function RegisterBatch(name: String, update: Void->Void): Void {}
+
+    // command runs when native asks for it by name, from a debug button
+    @:hlNative("builtin", "script_command_register")
+    public static function RegisterCommand(name: String, command: Void->Void): Void {}
+
+    // returns the object's slot in the transform arrays
+    @:hlNative("builtin", "script_transform_bind")
+    public static function BindTransform(object: Pointer): Int { return 0; }
+
+    @:hlNative("builtin", "script_transform_unbind")
+    public static function UnbindTransform(slot: Int): Void {}
+
+    // xyz per slot, written back to the transforms after every batch ran. only good for the batch that fetched it
+    @:hlNative("builtin", "script_transform_positions")
+    public static function Positions(): BytesAccess<Single> { return null; }
+
+    // xyzw per slot, same rules as Positions
+    @:hlNative("builtin", "script_transform_rotations")
+    public static function Rotations(): BytesAccess<Single> { return null; }
+
+    // what native does around the batches every frame, copying every bound transform in and out of the arrays.
+    // only for measuring, batches never need to call these
+    @:hlNative("builtin", "script_transform_gather")
+    public static function Gather(): Void {}
+
+    @:hlNative("builtin", "script_transform_apply")
+    public static function Apply(): Void {}
+}
@@ -3,22 +3,27 @@ package;
 import me.asset.MeshAsset;
 import me.components.MeshRenderer;
 import me.Time;
-import me.math.Vector3;
 import me.game.Component;
 
 class TestComponent extends Component {
     static var radius = 2;
     static var mesh: MeshAsset = null;
+    public static var batch(default, null) = new ComponentBatch<TestComponent>("TestComponent", UpdateBatch);
 
     override function OnStart() {
         var renderer = Components.Create(MeshRenderer);
         renderer.Mesh = mesh;
+        batch.Add(this);
     }
 
-    override function OnUpdate() {
-        var vector = Vector3.Zero();
-        vector.x = Math.sin(Time.Elapsed) * radius;
-        vector.z = Math.cos(Time.Elapsed) * radius;
-        Transform.Position = vector;
+    override function OnDestroy() {
+        batch.Remove(this);
+    }
+
+    static function UpdateBatch(batch: ComponentBatch<TestComponent>) {
+        var position = new Vec3(Math.sin(Time.Elapsed) * radius, 0, Math.cos(Time.Elapsed) * radius);
+        for (i in 0...batch.slots.length) {
+            batch.Transform(i).Position = position;
+        }
     }
 }
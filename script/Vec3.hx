@@ -0,0 +1,52 @@
+package;
+
+import hl.BytesAccess;
+
+// three floats for script side math. everything is inline, so a Vec3 that stays in locals
+// is taken apart into plain floats by the compiler and never reaches the gc.
+// storing one in a field or an array allocates it like any object
+final class Vec3 {
+    public var x: Float;
+    public var y: Float;
+    public var z: Float;
+
+    public inline function new(x: Float = 0, y: Float = 0, z: Float = 0) {
+        this.x = x;
+        this.y = y;
+        this.z = z;
+    }
+
+    public static inline function Zero(): Vec3 {
+        return new Vec3(0, 0, 0);
+    }
+
+    public inline function Add(other: Vec3): Vec3 {
+        return new Vec3(x + other.x, y + other.y, z + other.z);
+    }
+
+    public inline function Sub(other: Vec3): Vec3 {
+        return new Vec3(x - other.x, y - other.y, z - other.z);
+    }
+
+    public inline function Scale(scale: Float): Vec3 {
+        return new Vec3(x * scale, y * scale, z * scale);
+    }
+
+    public inline function Dot(other: Vec3): Float {
+        return x * other.x + y * other.y + z * other.z;
+    }
+
+    public inline function Length(): Float {
+        return Math.sqrt(Dot(this));
+    }
+
+    public static inline function Load(array: BytesAccess<Single>, slot: Int): Vec3 {
+        return new Vec3(array[slot * 3], array[slot * 3 + 1], array[slot * 3 + 2]);
+    }
+
+    public inline function Store(array: BytesAccess<Single>, slot: Int): Void {
+        array[slot * 3] = x;
+        array[slot * 3 + 1] = y;
+        array[slot * 3 + 2] = z;
+    }
+}
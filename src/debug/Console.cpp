@@ -0,0 +1,110 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "Console.h"
+
+#include <algorithm>
+#include <ctime>
+#include <string>
+#include <imgui.h>
+#include <spdlog/details/os.h>
+#include <spdlog/fmt/fmt.h>
+
+namespace me::debug {
+    static const ImVec4 LEVEL_COLORS[] = {
+        { 0.5f, 0.5f, 0.5f, 1.0f }, // trace
+        { 0.6f, 0.8f, 1.0f, 1.0f }, // debug
+        { 0.9f, 0.9f, 0.9f, 1.0f }, // info
+        { 1.0f, 0.8f, 0.3f, 1.0f }, // warn
+        { 1.0f, 0.4f, 0.4f, 1.0f }, // error
+        { 1.0f, 0.2f, 0.8f, 1.0f }, // critical
+    };
+
+    Console::Console(LogRing& ring) : ring(ring), history(ring.GetCapacity()) {
+    }
+
+    void Console::Refilter() {
+        shown.clear();
+        for (uint64_t i = first; i < end; i++) {
+            if (Passes(history[i % history.size()])) shown.push_back(i);
+        }
+    }
+
+    void Console::Take() {
+        incoming.clear();
+        lost += ring.Read(incoming);
+
+        for (const LogRecord& record : incoming) {
+            history[end % history.size()] = record;
+            if (Passes(record)) shown.push_back(end);
+            end++;
+            if (end - first > history.size()) first++;
+        }
+        while (!shown.empty() && shown.front() < first) {
+            shown.pop_front();
+        }
+    }
+
+    void Console::Clear() {
+        Take();
+        first = end;
+        shown.clear();
+    }
+
+    void Console::Draw(const char* title) {
+        Take();
+
+        if (!ImGui::Begin(title)) {
+            ImGui::End();
+            return;
+        }
+
+        bool changed = false;
+        for (int level = spdlog::level::trace; level < spdlog::level::off; level++) {
+            bool enabled = levelMask & (1u << level);
+            auto name = spdlog::level::to_string_view(static_cast<spdlog::level::level_enum>(level));
+            if (level != spdlog::level::trace) ImGui::SameLine();
+            if (ImGui::Checkbox(std::string(name.data(), name.size()).c_str(), &enabled)) {
+                levelMask ^= 1u << level;
+                changed = true;
+            }
+        }
+        if (changed) Refilter();
+
+        ImGui::SameLine();
+        ImGui::Checkbox("Auto-scroll", &autoScroll);
+        ImGui::SameLine();
+        if (ImGui::Button("Clear")) Clear();
+        ImGui::Text("%u / %u lines, %llu lost", static_cast<uint32_t>(shown.size()), static_cast<uint32_t>(end - first),
+                    static_cast<unsigned long long>(lost + ring.GetDropped()));
+        ImGui::Separator();
+
+        ImGui::BeginChild("Lines", ImVec2(0, 0), ImGuiChildFlags_None, ImGuiWindowFlags_HorizontalScrollbar);
+        bool atBottom = ImGui::GetScrollY() >= ImGui::GetScrollMaxY();
+
+        char line[LOG_MESSAGE_SIZE + 64];
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(shown.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                const LogRecord& record = history[shown[row] % history.size()];
+                std::time_t seconds = static_cast<std::time_t>(record.timestamp / 1000000000);
+                std::tm time = spdlog::details::os::localtime(seconds);
+                auto name = spdlog::level::to_string_view(record.level);
+                auto result = fmt::format_to_n(line, sizeof(line), "[{:02}:{:02}:{:02}.{:03}] [{}] [{}] {}", time.tm_hour, time.tm_min, time.tm_sec,
+                                               record.timestamp / 1000000 % 1000, record.thread, std::string_view(name.data(), name.size()),
+                                               std::string_view(record.message, record.length));
+
+                ImGui::PushStyleColor(ImGuiCol_Text, LEVEL_COLORS[record.level]);
+                ImGui::TextUnformatted(line, line + std::min(result.size, sizeof(line)));
+                ImGui::PopStyleColor();
+            }
+        }
+        clipper.End();
+
+        if (autoScroll && atBottom) ImGui::SetScrollHereY(1.0f);
+        ImGui::EndChild();
+        ImGui::End();
+    }
+}
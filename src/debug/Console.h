@@ -0,0 +1,43 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "LogRing.h"
+
+namespace me::debug {
+    // ImGui window over a LogRing. keeps as many records as the ring holds, and only lays out the lines in view
+    class Console {
+        private:
+        LogRing& ring;
+        std::vector<LogRecord> incoming;
+        // circular, record n lives at n % size
+        std::vector<LogRecord> history;
+        uint64_t first = 0;
+        uint64_t end = 0;
+        // records that pass the level filter, oldest first
+        std::deque<uint64_t> shown;
+        // one bit per spdlog level
+        uint32_t levelMask = ~0u;
+        bool autoScroll = true;
+        uint64_t lost = 0;
+
+        bool Passes(const LogRecord& record) const { return levelMask & (1u << record.level); }
+        void Refilter();
+        void Take();
+
+        public:
+        Console(LogRing& ring);
+
+        void Draw(const char* title);
+        void Clear();
+    };
+}
+
+#endif //CONSOLE_H
@@ -0,0 +1,134 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "LogRing.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <thread>
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/ostream_sink.h>
+
+namespace me::debug {
+    LogRing* mainLogRing = nullptr;
+
+    LogRing::LogRing(uint32_t capacity) {
+        uint64_t size = std::bit_ceil(std::max(capacity, 2u));
+        slots = std::make_unique<Slot[]>(size);
+        mask = size - 1;
+    }
+
+    void LogRing::Push(spdlog::level::level_enum level, int64_t timestamp, size_t thread, const char* message, size_t length) {
+        uint64_t position = writeIndex.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slots[position & mask];
+        uint64_t writing = position * 2 + 1;
+
+        uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        while (true) {
+            // a writer from a later lap got here first, this record is already older than what the ring holds
+            if (sequence >= writing) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            // the writer from the lap before is still copying, that only takes a moment
+            if (sequence & 1) {
+                std::this_thread::yield();
+                sequence = slot.sequence.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (slot.sequence.compare_exchange_weak(sequence, writing, std::memory_order_acquire, std::memory_order_relaxed)) break;
+        }
+        // the odd sequence has to be visible before any of the record changes
+        std::atomic_thread_fence(std::memory_order_release);
+
+        LogRecord& record = slot.record;
+        record.level = level;
+        record.timestamp = timestamp;
+        record.thread = thread;
+        record.length = static_cast<uint32_t>(std::min<size_t>(length, LOG_MESSAGE_SIZE));
+        std::memcpy(record.message, message, record.length);
+
+        slot.sequence.store(writing + 1, std::memory_order_release);
+    }
+
+    uint64_t LogRing::Read(std::vector<LogRecord>& out) {
+        uint64_t end = writeIndex.load(std::memory_order_acquire);
+        uint64_t lost = 0;
+        if (end - readIndex > mask + 1) {
+            lost = end - readIndex - (mask + 1);
+            readIndex = end - (mask + 1);
+        }
+
+        for (; readIndex < end; readIndex++) {
+            Slot& slot = slots[readIndex & mask];
+            uint64_t finished = readIndex * 2 + 2;
+            uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence < finished) break;
+            if (sequence > finished) {
+                lost++;
+                continue;
+            }
+
+            LogRecord record;
+            std::memcpy(&record, &slot.record, sizeof(LogRecord));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // a writer from the next lap started while this was copied
+            if (slot.sequence.load(std::memory_order_relaxed) != finished) {
+                lost++;
+                continue;
+            }
+            out.push_back(record);
+        }
+        return lost;
+    }
+
+    void LogRingSink::log(const spdlog::details::log_msg& msg) {
+        int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(msg.time.time_since_epoch()).count();
+        ring.Push(msg.level, timestamp, msg.thread_id, msg.payload.data(), msg.payload.size());
+    }
+
+    void AttachLogRing(LogRing& ring) {
+        auto sink = std::make_shared<LogRingSink>(ring);
+        // apply_all holds the registry lock, the loggers are swapped after it returns
+        std::vector<std::shared_ptr<spdlog::logger>> loggers;
+        spdlog::apply_all([&loggers](const std::shared_ptr<spdlog::logger>& logger) {
+            loggers.push_back(logger);
+        });
+        std::shared_ptr<spdlog::logger> defaultLogger = spdlog::default_logger();
+        if (defaultLogger && std::find(loggers.begin(), loggers.end(), defaultLogger) == loggers.end()) {
+            loggers.push_back(defaultLogger);
+        }
+
+        for (const std::shared_ptr<spdlog::logger>& logger : loggers) {
+            std::vector<spdlog::sink_ptr> sinks = logger->sinks();
+            std::erase_if(sinks, [](const spdlog::sink_ptr& existing) {
+                return dynamic_cast<spdlog::sinks::ostream_sink_mt*>(existing.get()) != nullptr ||
+                       dynamic_cast<spdlog::sinks::ostream_sink_st*>(existing.get()) != nullptr ||
+                       dynamic_cast<LogRingSink*>(existing.get()) != nullptr;
+            });
+            sinks.push_back(sink);
+
+            auto replacement = std::make_shared<spdlog::logger>(logger->name(), sinks.begin(), sinks.end());
+            replacement->set_level(logger->level());
+            replacement->flush_on(logger->flush_level());
+            if (logger == defaultLogger) {
+                // also swaps it in the registry under its name
+                spdlog::set_default_logger(replacement);
+            } else {
+                spdlog::drop(logger->name());
+                spdlog::register_logger(replacement);
+            }
+        }
+    }
+
+    std::shared_ptr<spdlog::logger> CreateLogger(const std::string& name) {
+        std::shared_ptr<spdlog::logger> defaultLogger = spdlog::default_logger();
+        std::vector<spdlog::sink_ptr> sinks;
+        if (defaultLogger) sinks = defaultLogger->sinks();
+        auto logger = std::make_shared<spdlog::logger>(name, sinks.begin(), sinks.end());
+        spdlog::initialize_logger(logger);
+        return logger;
+    }
+}
@@ -0,0 +1,86 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef LOGRING_H
+#define LOGRING_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <spdlog/logger.h>
+#include <spdlog/sinks/sink.h>
+
+namespace me::debug {
+    // longer messages are cut off
+    constexpr uint32_t LOG_MESSAGE_SIZE = 240;
+
+    struct LogRecord {
+        spdlog::level::level_enum level;
+        uint32_t length;
+        // nanoseconds since the epoch
+        int64_t timestamp;
+        size_t thread;
+        char message[LOG_MESSAGE_SIZE];
+    };
+
+    // fixed number of log records, any thread writes and one thread reads.
+    // writers claim a position with one atomic add and never wait on the reader, the oldest records get overwritten.
+    // it isn't lock-free: a writer whose slot is still being copied into by the writer from the lap before waits for it to finish.
+    // every slot has a sequence, odd while it's written, so the reader can tell finished, torn and overwritten records apart
+    class LogRing {
+        private:
+        struct Slot {
+            std::atomic<uint64_t> sequence = 0;
+            LogRecord record;
+        };
+
+        std::unique_ptr<Slot[]> slots;
+        uint64_t mask;
+        std::atomic<uint64_t> writeIndex = 0;
+        std::atomic<uint64_t> dropped = 0;
+        // reader only
+        uint64_t readIndex = 0;
+
+        public:
+        // rounded up to a power of two
+        LogRing(uint32_t capacity);
+
+        void Push(spdlog::level::level_enum level, int64_t timestamp, size_t thread, const char* message, size_t length);
+        // appends every record finished since the last call, stops at one that's still being written.
+        // returns how many were lost to the ring wrapping before they were read
+        uint64_t Read(std::vector<LogRecord>& out);
+
+        uint32_t GetCapacity() const { return static_cast<uint32_t>(mask + 1); }
+        // records a writer gave up on because a newer one had already taken the slot
+        uint64_t GetDropped() const { return dropped.load(std::memory_order_relaxed); }
+    };
+
+    // hands every message of the loggers it's added to over to a LogRing, no formatting and no sink mutex
+    class LogRingSink : public spdlog::sinks::sink {
+        private:
+        LogRing& ring;
+
+        public:
+        LogRingSink(LogRing& ring) : ring(ring) {}
+
+        void log(const spdlog::details::log_msg& msg) override;
+        void flush() override {}
+        void set_pattern(const std::string&) override {}
+        void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+    };
+
+    // replaces every registered logger, and the default one, with a copy that also has a sink for ring and no longer has the
+    // string stream sink the old console read from. a live logger's sinks can't be changed safely while other threads log
+    // through it, so the copies are swapped into the registry instead; anything still holding an old logger keeps logging
+    // without the ring. spdlog has no registry wide sinks or creation hook, so loggers made later go through CreateLogger
+    void AttachLogRing(LogRing& ring);
+    // makes and registers a logger with the default logger's sinks, so it reaches the ring once AttachLogRing has run
+    std::shared_ptr<spdlog::logger> CreateLogger(const std::string& name);
+
+    extern LogRing* mainLogRing;
+}
+
+#endif //LOGRING_H
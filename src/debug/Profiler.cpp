@@ -0,0 +1,188 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+
+namespace me::debug {
+    Profiler mainProfiler;
+
+    // escapes what a zone or thread name could contain that would break a json string
+    static void WriteJsonString(std::ofstream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') out << '\\';
+            if (static_cast<unsigned char>(*c) < 0x20) continue;
+            out << *c;
+        }
+        out << '"';
+    }
+
+    Profiler::ThreadOwner::~ThreadOwner() {
+        if (buffer == nullptr) return;
+        std::lock_guard lock(buffer->mutex);
+        buffer->retired = true;
+    }
+
+    Profiler::ThreadBuffer& Profiler::GetThreadBuffer() {
+        thread_local ThreadOwner owner;
+        if (owner.buffer != nullptr) return *owner.buffer;
+
+        std::lock_guard lock(threadsMutex);
+        auto created = std::make_unique<ThreadBuffer>();
+        if (!freeThreadIndices.empty()) {
+            created->index = freeThreadIndices.back();
+            freeThreadIndices.pop_back();
+        } else {
+            created->index = nextThreadIndex++;
+        }
+        created->name = fmt::format("Thread {}", created->index);
+        owner.buffer = created.get();
+        threads.push_back(std::move(created));
+        return *owner.buffer;
+    }
+
+    void Profiler::SetThreadName(const std::string& name) {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        std::lock_guard lock(buffer.mutex);
+        buffer.name = name;
+    }
+
+    std::string Profiler::GetThreadName(uint16_t thread) {
+        if (thread == PROFILER_GPU_THREAD) return "GPU";
+
+        std::lock_guard lock(threadsMutex);
+        for (auto& buffer : threads) {
+            if (buffer->index != thread) continue;
+            std::lock_guard bufferLock(buffer->mutex);
+            return buffer->name;
+        }
+        return {};
+    }
+
+    const char* Profiler::InternName(const std::string& name) {
+        std::lock_guard lock(namesMutex);
+        return names.insert(name).first->c_str();
+    }
+
+    uint64_t Profiler::Begin() {
+        GetThreadBuffer().depth++;
+        // 0 means the zone wasn't started
+        return std::max<uint64_t>(SDL_GetTicksNS(), 1);
+    }
+
+    void Profiler::End(const char* name, uint64_t begin) {
+        uint64_t end = SDL_GetTicksNS();
+        ThreadBuffer& buffer = GetThreadBuffer();
+        buffer.depth--;
+
+        std::lock_guard lock(buffer.mutex);
+        buffer.zones.push_back({ name, begin, end, buffer.depth, buffer.index });
+    }
+
+    void Profiler::AddGpuZone(const char* name, uint64_t begin, uint64_t end) {
+        if (!IsEnabled()) return;
+        std::lock_guard lock(gpu.mutex);
+        gpu.zones.push_back({ name, begin, end, 0, PROFILER_GPU_THREAD });
+    }
+
+    void Profiler::EndFrame() {
+        uint64_t now = SDL_GetTicksNS();
+
+        ProfileFrame frame = { frameNumber, frameBegin, now };
+        {
+            std::lock_guard lock(threadsMutex);
+            for (auto& thread : threads) {
+                std::lock_guard bufferLock(thread->mutex);
+                if (!thread->zones.empty()) thread->lastFrame = frameNumber;
+                frame.zones.insert(frame.zones.end(), thread->zones.begin(), thread->zones.end());
+                thread->zones.clear();
+            }
+        }
+        {
+            std::lock_guard lock(gpu.mutex);
+            frame.zones.insert(frame.zones.end(), gpu.zones.begin(), gpu.zones.end());
+            gpu.zones.clear();
+        }
+
+        frameBegin = now;
+        frameNumber++;
+        if (IsEnabled() || !frame.zones.empty()) {
+            frames.push_back(std::move(frame));
+            while (frames.size() > maxFrames) {
+                frames.pop_front();
+            }
+        }
+
+        // threads that exited, like workers from before a resize, stop taking up a row once their last zones scroll out
+        uint64_t oldestKept = frames.empty() ? frameNumber : frames.front().number;
+        std::lock_guard lock(threadsMutex);
+        std::erase_if(threads, [this, oldestKept](const std::unique_ptr<ThreadBuffer>& thread) {
+            std::lock_guard bufferLock(thread->mutex);
+            if (!thread->retired || !thread->zones.empty() || thread->lastFrame >= oldestKept) return false;
+            freeThreadIndices.push_back(thread->index);
+            return true;
+        });
+    }
+
+    bool Profiler::ExportChromeTrace(const std::string& path) {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            spdlog::error("Failed to open {} for the trace", path);
+            return false;
+        }
+        if (frames.empty()) {
+            out << "{\"traceEvents\":[]}\n";
+            return true;
+        }
+
+        // timestamps are microseconds from the first kept frame
+        uint64_t origin = frames.front().begin;
+        for (const ProfileFrame& frame : frames) {
+            for (const ProfileZone& zone : frame.zones) origin = std::min(origin, zone.begin);
+        }
+        auto micros = [origin](uint64_t ticks) { return static_cast<double>(ticks - origin) / 1000.0; };
+
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        std::vector<uint16_t> seenThreads;
+        bool first = true;
+        for (const ProfileFrame& frame : frames) {
+            for (const ProfileZone& zone : frame.zones) {
+                if (!first) out << ",\n";
+                first = false;
+                out << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << zone.thread << ",\"ts\":" << micros(zone.begin)
+                    << ",\"dur\":" << static_cast<double>(zone.end - zone.begin) / 1000.0 << ",\"name\":";
+                WriteJsonString(out, zone.name);
+                out << "}";
+                if (std::find(seenThreads.begin(), seenThreads.end(), zone.thread) == seenThreads.end()) {
+                    seenThreads.push_back(zone.thread);
+                }
+            }
+            // frame boundaries as instant events, so frames are easy to find in the viewer
+            if (!first) out << ",\n";
+            first = false;
+            out << "{\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":" << micros(frame.end)
+                << ",\"name\":\"Frame " << frame.number << "\"}";
+        }
+        for (uint16_t thread : seenThreads) {
+            out << ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+            WriteJsonString(out, GetThreadName(thread).c_str());
+            out << "}}";
+        }
+        out << "\n]}\n";
+
+        if (!out) {
+            spdlog::error("Failed to write the trace to {}", path);
+            return false;
+        }
+        spdlog::info("Wrote {} frames of profile to {}", frames.size(), path);
+        return true;
+    }
+}
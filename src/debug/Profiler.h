@@ -0,0 +1,137 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace me::debug {
+    // row the gpu spans are drawn and exported on
+    constexpr uint16_t PROFILER_GPU_THREAD = UINT16_MAX;
+
+    struct ProfileZone {
+        // has to outlive the frames the profiler keeps, a literal or a name from Profiler::InternName
+        const char* name;
+        uint64_t begin;
+        uint64_t end;
+        uint16_t depth;
+        uint16_t thread;
+    };
+
+    struct ProfileFrame {
+        uint64_t number;
+        uint64_t begin;
+        uint64_t end;
+        std::vector<ProfileZone> zones;
+    };
+
+    // collects timed zones from every thread and groups them into frames.
+    // each thread writes into its own buffer, EndFrame sweeps them into the frame that just ended.
+    // with the profiler off a zone costs one relaxed load
+    class Profiler {
+        private:
+        struct ThreadBuffer {
+            std::mutex mutex;
+            std::vector<ProfileZone> zones;
+            std::string name;
+            uint16_t index;
+            // only touched by the owning thread
+            uint16_t depth = 0;
+            // set when the owning thread exits, EndFrame drops the buffer once no kept frame has its zones
+            bool retired = false;
+            uint64_t lastFrame = 0;
+        };
+        // marks the calling thread's buffer retired when the thread exits
+        struct ThreadOwner {
+            ThreadBuffer* buffer = nullptr;
+            ~ThreadOwner();
+        };
+
+        std::atomic<bool> enabled = false;
+        std::mutex threadsMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> threads;
+        // indices of dropped buffers, handed to new threads so the rows don't keep growing
+        std::vector<uint16_t> freeThreadIndices;
+        uint16_t nextThreadIndex = 0;
+        ThreadBuffer gpu;
+
+        // node based, so the strings never move
+        std::mutex namesMutex;
+        std::unordered_set<std::string> names;
+
+        std::deque<ProfileFrame> frames;
+        uint32_t maxFrames = 300;
+        uint64_t frameNumber = 0;
+        uint64_t frameBegin = 0;
+
+        ThreadBuffer& GetThreadBuffer();
+
+        public:
+        void SetEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+        bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+        // shown on the calling thread's row
+        void SetThreadName(const std::string& name);
+        std::string GetThreadName(uint16_t thread);
+        // a copy of name that lives as long as the profiler, for zone names that aren't literals.
+        // takes a lock, so call it once when the name is made rather than per zone
+        const char* InternName(const std::string& name);
+
+        // returns the start time, End has to follow on the same thread
+        uint64_t Begin();
+        void End(const char* name, uint64_t begin);
+        // a span of gpu work, taken from any thread
+        void AddGpuZone(const char* name, uint64_t begin, uint64_t end);
+
+        // closes the current frame and starts the next, once per frame on the main thread
+        void EndFrame();
+
+        const std::deque<ProfileFrame>& GetFrames() const { return frames; }
+        void SetMaxFrames(uint32_t count) { maxFrames = count; }
+        uint32_t GetMaxFrames() const { return maxFrames; }
+
+        // every kept frame as Chrome trace event json, for chrome://tracing or Perfetto
+        bool ExportChromeTrace(const std::string& path);
+    };
+
+    // times the enclosing scope when the profiler is on
+    class ProfileScope {
+        private:
+        const char* name;
+        uint64_t begin;
+
+        public:
+        ProfileScope(const char* name);
+        ~ProfileScope();
+    };
+
+    // an object, not a pointer, zones can start before the app sets anything up
+    extern Profiler mainProfiler;
+
+    inline ProfileScope::ProfileScope(const char* name) : name(name), begin(mainProfiler.IsEnabled() ? mainProfiler.Begin() : 0) {
+    }
+
+    inline ProfileScope::~ProfileScope() {
+        if (begin != 0) mainProfiler.End(name, begin);
+    }
+}
+
+#define ME_PROFILE_CONCAT_INNER(a, b) a##b
+#define ME_PROFILE_CONCAT(a, b) ME_PROFILE_CONCAT_INNER(a, b)
+
+// ME_PROFILER_DISABLED compiles every zone out
+#ifdef ME_PROFILER_DISABLED
+#define ME_PROFILE_SCOPE(name)
+#else
+#define ME_PROFILE_SCOPE(name) ::me::debug::ProfileScope ME_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#endif
+
+#endif //PROFILER_H
@@ -0,0 +1,146 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "ProfilerView.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <functional>
+#include <string_view>
+#include <imgui.h>
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+
+namespace me::debug {
+    constexpr float TIMELINE_ROW_HEIGHT = 18.0f;
+    constexpr size_t MAX_TOTALS = 24;
+
+    // the same name always gets the same color, whichever frame it's in
+    static ImU32 ZoneColor(const char* name) {
+        size_t hash = std::hash<std::string_view>()(name);
+        return IM_COL32(80 + hash % 150, 80 + (hash >> 8) % 150, 80 + (hash >> 16) % 150, 255);
+    }
+
+    void ProfilerView::Export() {
+        char* prefPath = SDL_GetPrefPath("MANIFOLD", "MANIFOLDEngineTest");
+        if (!prefPath) {
+            spdlog::error("No pref path to write the trace to: {}", SDL_GetError());
+            return;
+        }
+        std::string path = std::string(prefPath) + "trace.json";
+        SDL_free(prefPath);
+        profiler.ExportChromeTrace(path);
+    }
+
+    void ProfilerView::Draw(const char* title) {
+        if (!ImGui::Begin(title)) {
+            ImGui::End();
+            return;
+        }
+
+        bool enabled = profiler.IsEnabled();
+        if (ImGui::Checkbox("Enabled", &enabled)) profiler.SetEnabled(enabled);
+        ImGui::SameLine();
+        if (ImGui::Button("Export Chrome Trace")) Export();
+
+        const auto& frames = profiler.GetFrames();
+        if (frames.empty()) {
+            ImGui::TextUnformatted("No frames recorded yet");
+            ImGui::End();
+            return;
+        }
+
+        frameTimes.clear();
+        for (const ProfileFrame& frame : frames) {
+            frameTimes.push_back(static_cast<float>(frame.end - frame.begin) / 1e6f);
+        }
+        ImGui::PlotHistogram("##Frame Times", frameTimes.data(), static_cast<int>(frameTimes.size()), 0, "frame ms", 0.0f, FLT_MAX,
+                             ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+
+        int last = static_cast<int>(frames.size()) - 1;
+        int index = selected < 0 ? last : std::min(selected, last);
+        if (ImGui::SliderInt("Frame", &index, 0, last)) selected = index;
+        ImGui::SameLine();
+        if (ImGui::Button("Newest")) selected = -1;
+        // stopping the profiler keeps the frames still, otherwise the picked one slides away as new ones come in
+        if (profiler.IsEnabled()) selected = -1;
+
+        const ProfileFrame& frame = frames[index];
+        ImGui::Text("Frame %llu: %.3f ms, %u zones", static_cast<unsigned long long>(frame.number), (frame.end - frame.begin) / 1e6,
+                    static_cast<uint32_t>(frame.zones.size()));
+
+        DrawTimeline(frame);
+        DrawTotals(frame);
+        ImGui::End();
+    }
+
+    void ProfilerView::DrawTimeline(const ProfileFrame& frame) {
+        rows.clear();
+        uint16_t maxDepth = 0;
+        for (const ProfileZone& zone : frame.zones) {
+            if (std::find(rows.begin(), rows.end(), zone.thread) == rows.end()) rows.push_back(zone.thread);
+            maxDepth = std::max(maxDepth, zone.depth);
+        }
+        // threads in the order they first profiled, gpu last
+        std::sort(rows.begin(), rows.end());
+
+        float rowHeight = TIMELINE_ROW_HEIGHT * (maxDepth + 1);
+        float labelWidth = 90.0f;
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        float width = std::max(ImGui::GetContentRegionAvail().x - labelWidth, 1.0f);
+        double scale = width / static_cast<double>(std::max<uint64_t>(frame.end - frame.begin, 1));
+
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        ImVec2 mouse = ImGui::GetMousePos();
+        for (size_t row = 0; row < rows.size(); row++) {
+            float top = origin.y + row * (rowHeight + 4.0f);
+            drawList->AddText(ImVec2(origin.x, top), IM_COL32_WHITE, profiler.GetThreadName(rows[row]).c_str());
+            drawList->AddRectFilled(ImVec2(origin.x + labelWidth, top), ImVec2(origin.x + labelWidth + width, top + rowHeight),
+                                    IM_COL32(40, 40, 40, 255));
+
+            for (const ProfileZone& zone : frame.zones) {
+                if (zone.thread != rows[row]) continue;
+                // zones from a thread that isn't in step with frames can hang over either end
+                double begin = std::max(static_cast<double>(zone.begin) - static_cast<double>(frame.begin), 0.0) * scale;
+                double end = std::min(static_cast<double>(zone.end) - static_cast<double>(frame.begin), static_cast<double>(frame.end - frame.begin)) * scale;
+                if (end <= begin) continue;
+
+                ImVec2 min(origin.x + labelWidth + static_cast<float>(begin), top + zone.depth * TIMELINE_ROW_HEIGHT);
+                ImVec2 max(origin.x + labelWidth + std::max(static_cast<float>(end), static_cast<float>(begin) + 1.0f),
+                           min.y + TIMELINE_ROW_HEIGHT - 1.0f);
+                drawList->AddRectFilled(min, max, ZoneColor(zone.name));
+                if (max.x - min.x > ImGui::CalcTextSize(zone.name).x + 4.0f) {
+                    drawList->AddText(ImVec2(min.x + 2.0f, min.y + 1.0f), IM_COL32_BLACK, zone.name);
+                }
+                if (mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y) {
+                    ImGui::SetTooltip("%s: %.3f ms", zone.name, (zone.end - zone.begin) / 1e6);
+                }
+            }
+        }
+        ImGui::Dummy(ImVec2(labelWidth + width, rows.size() * (rowHeight + 4.0f)));
+    }
+
+    void ProfilerView::DrawTotals(const ProfileFrame& frame) {
+        if (!ImGui::TreeNode("Totals")) return;
+
+        // inclusive time, a zone nested in one with the same name counts twice
+        totals.clear();
+        for (const ProfileZone& zone : frame.zones) {
+            auto it = std::find_if(totals.begin(), totals.end(), [&zone](const auto& total) {
+                return total.first == zone.name || std::string_view(total.first) == zone.name;
+            });
+            if (it == totals.end()) {
+                totals.emplace_back(zone.name, zone.end - zone.begin);
+            } else {
+                it->second += zone.end - zone.begin;
+            }
+        }
+        std::sort(totals.begin(), totals.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+
+        for (size_t i = 0; i < std::min(totals.size(), MAX_TOTALS); i++) {
+            ImGui::Text("%8.3f ms  %s", totals[i].second / 1e6, totals[i].first);
+        }
+        ImGui::TreePop();
+    }
+}
@@ -0,0 +1,39 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef PROFILERVIEW_H
+#define PROFILERVIEW_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Profiler.h"
+
+namespace me::debug {
+    // ImGui window over a Profiler: frame time history, one frame's zones on a timeline per thread,
+    // and where that frame's time went by zone name
+    class ProfilerView {
+        private:
+        Profiler& profiler;
+        // index into the kept frames, -1 follows the newest
+        int selected = -1;
+        std::vector<float> frameTimes;
+        std::vector<std::pair<const char*, uint64_t>> totals;
+        std::vector<uint16_t> rows;
+
+        void DrawTimeline(const ProfileFrame& frame);
+        void DrawTotals(const ProfileFrame& frame);
+
+        public:
+        ProfilerView(Profiler& profiler) : profiler(profiler) {}
+
+        void Draw(const char* title);
+        // the trace goes to the pref path
+        void Export();
+    };
+}
+
+#endif //PROFILERVIEW_H
@@ -38,6 +38,8 @@
 #endif
 #include <SDL3/SDL_gpu.h>
 
+#include "../render/UploadRing.h"
+
 // SDL_GPUDevice data
 struct ImGui_ImplSDLGPU3_Data
 {
@@ -435,13 +437,25 @@ void ImGui_ImplSDLGPU3_RenderDrawData(ImDrawData* draw_data, SDL_GPUCommandBuffe
             SDL_SetGPUBufferName(bd->Device, bd->IndexBuffer, "ImguiIndexBuffer");
         }
 
-        // TODO: Reuse the transfer buffer?
-        SDL_GPUTransferBufferCreateInfo transfer_info{};
-        transfer_info.size = vertex_size + index_size;
-        transfer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-        SDL_GPUTransferBuffer* transfer_buffer = SDL_CreateGPUTransferBuffer(bd->Device, &transfer_info);
-
-        void* map = SDL_MapGPUTransferBuffer(bd->Device, transfer_buffer, false);
+        // Stage through the shared upload ring, only fall back to a one-off transfer buffer if it can't fit this frame
+        me::render::UploadAllocation allocation{};
+        SDL_GPUTransferBuffer* transfer_buffer = nullptr;
+        void* map = nullptr;
+        bool use_ring = me::render::mainUploadRing != nullptr &&
+                        me::render::mainUploadRing->Allocate((uint32_t)(vertex_size + index_size), 4, allocation, true);
+        if(use_ring)
+        {
+            transfer_buffer = allocation.location.transfer_buffer;
+            map = allocation.data;
+        }
+        else
+        {
+            SDL_GPUTransferBufferCreateInfo transfer_info{};
+            transfer_info.size = vertex_size + index_size;
+            transfer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+            transfer_buffer = SDL_CreateGPUTransferBuffer(bd->Device, &transfer_info);
+            map = SDL_MapGPUTransferBuffer(bd->Device, transfer_buffer, false);
+        }
 
         // Upload vertex/index data into a single contiguous GPU buffer
         ImDrawVert* vtx_dst = reinterpret_cast<ImDrawVert*>(map);
@@ -455,17 +469,22 @@ void ImGui_ImplSDLGPU3_RenderDrawData(ImDrawData* draw_data, SDL_GPUCommandBuffe
             vtx_dst += cmd_list->VtxBuffer.Size;
             idx_dst += cmd_list->IdxBuffer.Size;
         }
-        SDL_UnmapGPUTransferBuffer(bd->Device, transfer_buffer);
+        if(use_ring)
+            me::render::mainUploadRing->Unmap();
+        else
+            SDL_UnmapGPUTransferBuffer(bd->Device, transfer_buffer);
 
         SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass(cmd);
 
+        uint32_t base_offset = use_ring ? allocation.location.offset : 0;
+
         SDL_GPUTransferBufferLocation vertex_location{};
         vertex_location.transfer_buffer = transfer_buffer;
-        vertex_location.offset = 0;
+        vertex_location.offset = base_offset;
 
         SDL_GPUTransferBufferLocation index_location{};
         index_location.transfer_buffer = transfer_buffer;
-        index_location.offset = vertex_size;
+        index_location.offset = base_offset + vertex_size;
 
         SDL_GPUBufferRegion vertex_region{};
         vertex_region.buffer = bd->VertexBuffer;
@@ -481,7 +500,8 @@ void ImGui_ImplSDLGPU3_RenderDrawData(ImDrawData* draw_data, SDL_GPUCommandBuffe
         SDL_UploadToGPUBuffer(copy_pass, &index_location, &index_region, true);
         SDL_EndGPUCopyPass(copy_pass);
 
-        SDL_ReleaseGPUTransferBuffer(bd->Device, transfer_buffer);
+        if(!use_ring)
+            SDL_ReleaseGPUTransferBuffer(bd->Device, transfer_buffer);
     }
 
     SDL_GPUColorTargetInfo color_target_info{};
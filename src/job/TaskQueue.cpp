@@ -0,0 +1,47 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "TaskQueue.h"
+
+#include <algorithm>
+
+namespace me::job {
+    TaskQueue::TaskQueue(uint32_t threadCount) {
+        if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+        for (uint32_t i = 0; i < threadCount; i++) {
+            threads.emplace_back(&TaskQueue::WorkerMain, this);
+        }
+    }
+
+    TaskQueue::~TaskQueue() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : threads) thread.join();
+    }
+
+    void TaskQueue::Submit(std::function<void()> task) {
+        {
+            std::lock_guard lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+        wake.notify_one();
+    }
+
+    void TaskQueue::WorkerMain() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex);
+                wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+}
@@ -0,0 +1,40 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef TASKQUEUE_H
+#define TASKQUEUE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace me::job {
+    // threads running independent tasks first in, first out. for long or blocking work like file loads,
+    // unlike WorkerPool nothing waits on a task here
+    class TaskQueue {
+        private:
+        std::vector<std::thread> threads;
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable wake;
+        bool stopping = false;
+
+        void WorkerMain();
+
+        public:
+        // 0 uses one thread per hardware thread
+        TaskQueue(uint32_t threadCount = 0);
+        // finishes the tasks already queued
+        ~TaskQueue();
+
+        void Submit(std::function<void()> task);
+        uint32_t GetThreadCount() const { return static_cast<uint32_t>(threads.size()); }
+    };
+}
+
+#endif //TASKQUEUE_H
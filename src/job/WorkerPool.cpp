@@ -0,0 +1,107 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <spdlog/fmt/fmt.h>
+
+#include "../debug/Profiler.h"
+
+namespace me::job {
+    WorkerPool* mainWorkers = nullptr;
+
+    WorkerPool::WorkerPool(uint32_t workerCount) {
+        Start(workerCount);
+    }
+
+    WorkerPool::~WorkerPool() {
+        Stop();
+    }
+
+    void WorkerPool::Start(uint32_t workerCount) {
+        if (workerCount == 0) workerCount = std::max(1u, std::thread::hardware_concurrency());
+
+        stopping = false;
+        for (uint32_t worker = 1; worker < workerCount; worker++) {
+            threads.emplace_back(&WorkerPool::WorkerMain, this, worker);
+        }
+    }
+
+    void WorkerPool::Stop() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : threads) thread.join();
+        threads.clear();
+    }
+
+    void WorkerPool::SetWorkerCount(uint32_t workerCount) {
+        std::lock_guard caller(callerMutex);
+        if (workerCount == GetWorkerCount()) return;
+        Stop();
+        Start(workerCount);
+    }
+
+    void WorkerPool::RunChunks(uint32_t worker) {
+        ME_PROFILE_SCOPE("Worker Chunks");
+        while (true) {
+            uint32_t begin = nextBegin.fetch_add(grain, std::memory_order_relaxed);
+            if (begin >= count) break;
+            (*task)(begin, std::min(begin + grain, count), worker);
+        }
+    }
+
+    void WorkerPool::WorkerMain(uint32_t worker) {
+        debug::mainProfiler.SetThreadName(fmt::format("Worker {}", worker));
+        uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock lock(mutex);
+                wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+
+            RunChunks(worker);
+
+            std::lock_guard lock(mutex);
+            if (--running == 0) done.notify_one();
+        }
+    }
+
+    void WorkerPool::ParallelFor(uint32_t count, uint32_t grain, const RangeTask& task) {
+        if (count == 0) return;
+        grain = std::max(1u, grain);
+
+        std::lock_guard caller(callerMutex);
+        // not worth waking anyone for a single chunk
+        if (threads.empty() || count <= grain) {
+            for (uint32_t begin = 0; begin < count; begin += grain) {
+                task(begin, std::min(begin + grain, count), 0);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            this->task = &task;
+            this->count = count;
+            this->grain = grain;
+            nextBegin.store(0, std::memory_order_relaxed);
+            running = static_cast<uint32_t>(threads.size());
+            generation++;
+        }
+        wake.notify_all();
+
+        RunChunks(0);
+
+        // every worker checks in, even ones that found no chunk left, so the next call can't be missed
+        std::unique_lock lock(mutex);
+        done.wait(lock, [this] { return running == 0; });
+        this->task = nullptr;
+    }
+}
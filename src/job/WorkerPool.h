@@ -0,0 +1,61 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace me::job {
+    // begin, end, worker index. worker 0 is the thread that called ParallelFor
+    typedef std::function<void(uint32_t, uint32_t, uint32_t)> RangeTask;
+
+    // fixed set of threads that split ranges between them.
+    // ParallelFor blocks, and the calling thread works on chunks too, so a pool of one worker runs everything inline.
+    // several threads may share a pool, their calls take turns. tasks can't call back into it
+    class WorkerPool {
+        private:
+        std::vector<std::thread> threads;
+        // held for a whole ParallelFor, so calls from different threads run one after the other
+        std::mutex callerMutex;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+
+        const RangeTask* task = nullptr;
+        uint32_t count = 0;
+        uint32_t grain = 0;
+        std::atomic<uint32_t> nextBegin = 0;
+        uint64_t generation = 0;
+        uint32_t running = 0;
+        bool stopping = false;
+
+        void WorkerMain(uint32_t worker);
+        void RunChunks(uint32_t worker);
+        void Start(uint32_t workerCount);
+        void Stop();
+
+        public:
+        // 0 uses one worker per hardware thread
+        WorkerPool(uint32_t workerCount = 0);
+        ~WorkerPool();
+
+        // restarts the threads, counts the calling thread
+        void SetWorkerCount(uint32_t workerCount);
+        uint32_t GetWorkerCount() const { return static_cast<uint32_t>(threads.size()) + 1; }
+
+        // runs task over [0, count) in chunks of grain elements, every chunk but the last starts at a multiple of grain
+        void ParallelFor(uint32_t count, uint32_t grain, const RangeTask& task);
+    };
+
+    extern WorkerPool* mainWorkers;
+}
+
+#endif //WORKERPOOL_H
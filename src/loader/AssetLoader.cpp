@@ -0,0 +1,179 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "AssetLoader.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <spdlog/spdlog.h>
+
+#include "CookedMesh.h"
+#include "fs/FileSystem.h"
+
+namespace me::loader {
+    struct ShaderFile {
+        char* data;
+        size_t size;
+        std::string nativePath;
+    };
+
+    // the vfs serves the copy of assets made at build time. dev builds get the source tree's assets directory,
+    // so a shader edited there is what's watched and reread rather than a copy that only changes on the next build
+    static std::string GetSourcePath(const std::string& path, const std::string& nativePath) {
+#ifdef ME_SOURCE_ASSET_DIR
+        std::filesystem::path source = std::filesystem::path(ME_SOURCE_ASSET_DIR) / std::filesystem::path(path).relative_path();
+        std::error_code error;
+        if (std::filesystem::is_regular_file(source, error)) return source.string();
+#endif
+        return nativePath;
+    }
+
+    static ShaderFile ReadShaderFile(const std::string& path) {
+        vfspp::IFilePtr file = fs::OpenFile(path);
+        if (!file || !file->IsOpened()) {
+            spdlog::error("Failed to load shader: {}", path);
+            return { nullptr, 0, {} };
+        }
+
+        size_t size = file->Size();
+        char* buffer = new char[size + 1];
+        memset(buffer, 0, size + 1);
+        file->Read(reinterpret_cast<uint8_t*>(buffer), size);
+        file->Close();
+        spdlog::info("Opened shader: {}", path);
+        return { buffer, size, GetSourcePath(path, file->GetFileInfo().AbsolutePath()) };
+    }
+
+    static ShaderFile ReadNativeShaderFile(const std::string& nativePath) {
+        std::ifstream file(nativePath, std::ios::binary);
+        if (!file) {
+            spdlog::error("Failed to load shader: {}", nativePath);
+            return { nullptr, 0, {} };
+        }
+
+        std::string code((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        char* buffer = new char[code.size() + 1];
+        memcpy(buffer, code.data(), code.size());
+        buffer[code.size()] = '\0';
+        return { buffer, code.size(), nativePath };
+    }
+
+    AssetLoader::AssetLoader(uint32_t threadCount) : tasks(threadCount) {}
+
+    std::shared_future<std::vector<ImportedMesh>> AssetLoader::LoadGltf(const std::string& path, const ImportOptions& options) {
+        return Load<std::vector<ImportedMesh>, std::vector<ImportedMesh>>(
+            [path, options] { return DecodeGltfCached(path, options); },
+            [](std::vector<ImportedMesh>& meshes) {
+                CreateMeshes(meshes);
+                return meshes;
+            });
+    }
+
+    std::shared_future<asset::ShaderPtr> AssetLoader::LoadShader(const std::string& path, asset::ShaderType type) {
+        return Load<ShaderFile, asset::ShaderPtr>(
+            [path] { return ReadShaderFile(path); },
+            [this, path, type](ShaderFile& file) -> asset::ShaderPtr {
+                if (file.data == nullptr) return nullptr;
+
+                // kept so the renderer can compile its own variants of materials made from this shader
+                auto source = std::make_shared<render::ShaderSource>();
+                source->name = path;
+                source->code.assign(file.data, file.size);
+                source->stage = type == asset::ShaderType::Vertex ? SDL_GPU_SHADERSTAGE_VERTEX : SDL_GPU_SHADERSTAGE_FRAGMENT;
+                source->entrypoint = type == asset::ShaderType::Vertex ? "vertex" : "fragment";
+                source->includeDirectory = std::filesystem::path(file.nativePath).parent_path().string();
+
+                auto shader = std::make_shared<asset::Shader>(false, type, file.data, file.size);
+                shaderSources[shader.get()] = source;
+                shaderPaths[file.nativePath] = path;
+                if (watcher) watcher->Watch(file.nativePath);
+                return shader;
+            });
+    }
+
+    void AssetLoader::ReloadShader(const std::string& path, const std::string& nativePath) {
+        uint64_t sequence = ++reloadSequence;
+        Load<ShaderFile, bool>(
+            [nativePath] { return ReadNativeShaderFile(nativePath); },
+            [this, path, sequence](ShaderFile& file) {
+                if (file.data == nullptr) return false;
+                uint64_t& applied = appliedReloads[path];
+                if (sequence < applied) {
+                    delete[] file.data;
+                    return false;
+                }
+                applied = sequence;
+
+                for (auto& [shader, source] : shaderSources) {
+                    if (source->name != path) continue;
+                    auto reloaded = std::make_shared<render::ShaderSource>(*source);
+                    reloaded->code.assign(file.data, file.size);
+                    render::ReplaceShaderSource(source, reloaded);
+                    source = reloaded;
+                }
+                delete[] file.data;
+                spdlog::info("Reloaded shader: {}", path);
+                return true;
+            });
+    }
+
+    void AssetLoader::SetHotReload(bool enabled) {
+        if (!enabled) {
+            watcher.reset();
+            return;
+        }
+        if (watcher) return;
+
+        watcher = std::make_unique<FileWatcher>();
+        for (const auto& [nativePath, path] : shaderPaths) watcher->Watch(nativePath);
+    }
+
+    std::shared_future<asset::MaterialPtr> AssetLoader::LoadMaterial(std::shared_future<asset::ShaderPtr> vertexShader,
+                                                                     std::shared_future<asset::ShaderPtr> fragmentShader) {
+        auto promise = std::make_shared<std::promise<asset::MaterialPtr>>();
+        std::shared_future<asset::MaterialPtr> future = promise->get_future().share();
+        materials.push_back({ std::move(vertexShader), std::move(fragmentShader), promise });
+        pending++;
+        return future;
+    }
+
+    void AssetLoader::Update() {
+        if (watcher) {
+            watcher->TakeChanged(changedFiles);
+            for (const std::string& nativePath : changedFiles) {
+                auto found = shaderPaths.find(nativePath);
+                if (found != shaderPaths.end()) ReloadShader(found->second, nativePath);
+            }
+            changedFiles.clear();
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            finishing.swap(completions);
+        }
+        for (auto& finish : finishing) finish();
+        pending -= static_cast<uint32_t>(finishing.size());
+        finishing.clear();
+
+        auto isReady = [](const std::shared_future<asset::ShaderPtr>& future) {
+            return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        };
+        std::erase_if(materials, [this, &isReady](PendingMaterial& material) {
+            if (!isReady(material.vertexShader) || !isReady(material.fragmentShader)) return false;
+
+            asset::MaterialPtr result;
+            if (material.vertexShader.get() && material.fragmentShader.get()) {
+                result = std::make_shared<asset::Material>(material.vertexShader.get(), material.fragmentShader.get());
+                // the renderer builds its pipelines from these in the background, through the shader cache
+                render::RegisterMaterialSources(result.get(), { shaderSources[material.vertexShader.get().get()],
+                                                                shaderSources[material.fragmentShader.get().get()] });
+            }
+            material.promise->set_value(result);
+            pending--;
+            return true;
+        });
+    }
+}
@@ -0,0 +1,131 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef ASSETLOADER_H
+#define ASSETLOADER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#include "asset/Material.h"
+#include "asset/Shader.h"
+#include "FileWatcher.h"
+#include "GltfImporter.h"
+#include "../job/TaskQueue.h"
+#include "../render/ShaderCompiler.h"
+
+namespace me::loader {
+    // loads assets in two halves. reading and decoding run on the loader's threads,
+    // anything that touches the engine or the gpu device (creating Mesh, Shader, Material) runs in Update on the main thread.
+    // the returned futures become ready in Update, so every load overlaps with the others and with rendering.
+    // uploads of loaded meshes go through the render pipeline's budgeted queue once they're added to a render list
+    class AssetLoader {
+        private:
+        struct PendingMaterial {
+            std::shared_future<asset::ShaderPtr> vertexShader;
+            std::shared_future<asset::ShaderPtr> fragmentShader;
+            std::shared_ptr<std::promise<asset::MaterialPtr>> promise;
+        };
+
+        std::mutex mutex;
+        std::condition_variable completed;
+        std::vector<std::function<void()>> completions;
+        std::vector<std::function<void()>> finishing;
+        std::vector<PendingMaterial> materials;
+        // source of every shader loaded so far, registered with the materials made from them
+        std::unordered_map<const asset::Shader*, render::ShaderSourcePtr> shaderSources;
+        // native path -> virtual path of every shader loaded so far.
+        // with ME_SOURCE_ASSET_DIR the native path is the file in the source tree, not the copy the vfs read
+        std::unordered_map<std::string, std::string> shaderPaths;
+        std::unique_ptr<FileWatcher> watcher;
+        std::vector<std::string> changedFiles;
+        // reloads finish in whatever order their reads do, an older save must not replace a newer one
+        uint64_t reloadSequence = 0;
+        // virtual path -> sequence of the reload last applied to it
+        std::unordered_map<std::string, uint64_t> appliedReloads;
+        std::atomic<uint32_t> pending = 0;
+        // last, so the threads are joined before anything they touch goes away
+        job::TaskQueue tasks;
+
+        template <typename Decoded, typename Result>
+        std::shared_future<Result> Load(std::function<Decoded()> decode, std::function<Result(Decoded&)> finish) {
+            auto promise = std::make_shared<std::promise<Result>>();
+            std::shared_future<Result> future = promise->get_future().share();
+            pending++;
+
+            // a load that throws fails like one that can't read its file, with an empty result,
+            // the promise is still set so nothing waits on it forever
+            tasks.Submit([this, promise, decode, finish] {
+                std::shared_ptr<Decoded> decoded;
+                try {
+                    decoded = std::make_shared<Decoded>(decode());
+                } catch (const std::exception& e) {
+                    spdlog::error("Asset load failed: {}", e.what());
+                }
+                {
+                    std::lock_guard lock(mutex);
+                    completions.push_back([promise, decoded, finish] {
+                        if (!decoded) {
+                            promise->set_value(Result {});
+                            return;
+                        }
+                        try {
+                            promise->set_value(finish(*decoded));
+                        } catch (const std::exception& e) {
+                            spdlog::error("Asset load failed: {}", e.what());
+                            promise->set_value(Result {});
+                        }
+                    });
+                }
+                completed.notify_all();
+            });
+            return future;
+        }
+
+        // rereads a shader from its native path and swaps its source into the materials made from it, they're rebuilt by the renderer
+        void ReloadShader(const std::string& path, const std::string& nativePath);
+
+        public:
+        // 0 uses one thread per hardware thread
+        AssetLoader(uint32_t threadCount = 0);
+
+        // goes through the cooked mesh cache
+        std::shared_future<std::vector<ImportedMesh>> LoadGltf(const std::string& path, const ImportOptions& options = {});
+        // null if the file can't be read
+        std::shared_future<asset::ShaderPtr> LoadShader(const std::string& path, asset::ShaderType type);
+        // created, pipeline included, as soon as both shaders are in
+        std::shared_future<asset::MaterialPtr> LoadMaterial(std::shared_future<asset::ShaderPtr> vertexShader,
+                                                            std::shared_future<asset::ShaderPtr> fragmentShader);
+
+        // watches loaded shaders and reloads them when they're saved, materials keep their old pipeline if the new source fails
+        void SetHotReload(bool enabled);
+        bool GetHotReload() const { return watcher != nullptr; }
+
+        // finishes decoded loads on the calling thread, call once per frame from the main thread
+        void Update();
+        uint32_t GetPending() const { return pending.load(); }
+
+        // keeps finishing loads until this one is ready, for things startup can't go on without
+        template <typename T>
+        T Wait(const std::shared_future<T>& future) {
+            while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                Update();
+                std::unique_lock lock(mutex);
+                completed.wait_for(lock, std::chrono::milliseconds(1), [this] { return !completions.empty(); });
+            }
+            return future.get();
+        }
+    };
+}
+
+#endif //ASSETLOADER_H
@@ -0,0 +1,280 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "CookedMesh.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+
+#include "../util/Hash.h"
+
+namespace me::loader {
+    struct CookedHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t sourceHash;
+        uint64_t fileSize;
+        uint32_t meshCount;
+        uint32_t padding;
+    };
+
+    struct CookedMeshEntry {
+        uint64_t nameOffset;
+        uint64_t submeshOffset;
+        uint64_t materialOffset;
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        uint64_t lodOffset;
+        uint32_t nameLength;
+        uint32_t submeshCount;
+        uint32_t materialCount;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t indexFormat;
+        uint32_t vertexFormat;
+        uint32_t lodCount;
+        float boundsMin[3];
+        float boundsMax[3];
+    };
+
+    constexpr size_t COOKED_ALIGNMENT = 16;
+
+    static std::mutex cacheMutex;
+    static std::string cacheDirectory;
+
+    static size_t Align(size_t offset) {
+        return (offset + COOKED_ALIGNMENT - 1) & ~(COOKED_ALIGNMENT - 1);
+    }
+
+    bool WriteCookedMeshes(const std::string& nativePath, uint64_t sourceHash, const std::vector<ImportedMesh>& meshes) {
+        std::vector<CookedMeshEntry> entries(meshes.size());
+
+        // lay everything out first, then write it front to back
+        size_t offset = sizeof(CookedHeader) + sizeof(CookedMeshEntry) * meshes.size();
+        for (size_t i = 0; i < meshes.size(); i++) {
+            const render::MeshGeometry& geometry = *meshes[i].geometry;
+            CookedMeshEntry& entry = entries[i];
+
+            entry.nameOffset = offset;
+            entry.nameLength = static_cast<uint32_t>(meshes[i].name.size());
+            offset = Align(offset + entry.nameLength);
+            entry.submeshOffset = offset;
+            entry.submeshCount = static_cast<uint32_t>(geometry.submeshes.size());
+            offset = Align(offset + sizeof(render::Submesh) * entry.submeshCount);
+            entry.materialOffset = offset;
+            entry.materialCount = static_cast<uint32_t>(meshes[i].materials.size());
+            offset = Align(offset + sizeof(int32_t) * entry.materialCount);
+            entry.lodOffset = offset;
+            entry.lodCount = static_cast<uint32_t>(geometry.lods.size());
+            offset = Align(offset + sizeof(render::MeshLod) * entry.lodCount);
+            entry.vertexOffset = offset;
+            entry.vertexCount = geometry.vertexCount;
+            entry.vertexFormat = static_cast<uint32_t>(geometry.vertexFormat);
+            offset = Align(offset + geometry.GetVertexBytes());
+            entry.indexOffset = offset;
+            entry.indexCount = geometry.indexCount;
+            entry.indexFormat = static_cast<uint32_t>(geometry.indexFormat);
+            offset = Align(offset + geometry.GetIndexBytes());
+
+            render::MeshGeometry bounded = geometry;
+            if (!bounded.hasBounds) render::ComputeBounds(bounded);
+            memcpy(entry.boundsMin, bounded.boundsMin, sizeof(entry.boundsMin));
+            memcpy(entry.boundsMax, bounded.boundsMax, sizeof(entry.boundsMax));
+        }
+
+        CookedHeader header = { COOKED_MESH_MAGIC, COOKED_MESH_VERSION, sourceHash, offset, static_cast<uint32_t>(meshes.size()), 0 };
+
+        // written next to the target and renamed, so a reader never maps a half written file
+        std::string temporary = fmt::format("{}.{}.tmp", nativePath, SDL_GetCurrentThreadID());
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+
+            size_t written = 0;
+            auto write = [&out, &written](const void* data, size_t size) {
+                out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+                written += size;
+            };
+            auto pad = [&out, &written](size_t to) {
+                static const char zeros[COOKED_ALIGNMENT] = {};
+                out.write(zeros, static_cast<std::streamsize>(to - written));
+                written = to;
+            };
+
+            write(&header, sizeof(header));
+            write(entries.data(), sizeof(CookedMeshEntry) * entries.size());
+            for (size_t i = 0; i < meshes.size(); i++) {
+                const render::MeshGeometry& geometry = *meshes[i].geometry;
+                const CookedMeshEntry& entry = entries[i];
+
+                write(meshes[i].name.data(), entry.nameLength);
+                pad(entry.submeshOffset);
+                write(geometry.submeshes.data(), sizeof(render::Submesh) * entry.submeshCount);
+                pad(entry.materialOffset);
+                for (int material : meshes[i].materials) {
+                    int32_t slot = material;
+                    write(&slot, sizeof(slot));
+                }
+                pad(entry.lodOffset);
+                write(geometry.lods.data(), sizeof(render::MeshLod) * entry.lodCount);
+                pad(entry.vertexOffset);
+                write(geometry.GetVertexData(), geometry.GetVertexBytes());
+                pad(entry.indexOffset);
+                write(geometry.indices, geometry.GetIndexBytes());
+                pad(Align(entry.indexOffset + geometry.GetIndexBytes()));
+            }
+            if (!out) {
+                out.close();
+                std::filesystem::remove(temporary);
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, nativePath, error);
+        if (error) {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+        return true;
+    }
+
+    bool ReadCookedMeshes(const MappedFilePtr& file, uint64_t sourceHash, std::vector<ImportedMesh>& out) {
+        const uint8_t* data = file->GetData();
+        size_t size = file->GetSize();
+        if (size < sizeof(CookedHeader)) return false;
+
+        CookedHeader header;
+        memcpy(&header, data, sizeof(header));
+        if (header.magic != COOKED_MESH_MAGIC || header.version != COOKED_MESH_VERSION || header.sourceHash != sourceHash || header.fileSize != size) {
+            return false;
+        }
+        if (sizeof(CookedHeader) + sizeof(CookedMeshEntry) * static_cast<size_t>(header.meshCount) > size) return false;
+
+        auto fits = [size](uint64_t offset, uint64_t bytes) { return offset <= size && bytes <= size - offset; };
+
+        std::vector<ImportedMesh> meshes;
+        for (uint32_t i = 0; i < header.meshCount; i++) {
+            CookedMeshEntry entry;
+            memcpy(&entry, data + sizeof(CookedHeader) + sizeof(CookedMeshEntry) * i, sizeof(entry));
+            if (entry.indexFormat > static_cast<uint32_t>(render::IndexFormat::UInt32)) return false;
+            if (entry.vertexFormat > static_cast<uint32_t>(render::VertexFormat::UNorm16)) return false;
+
+            auto geometry = std::make_shared<render::MeshGeometry>();
+            geometry->vertexCount = entry.vertexCount;
+            geometry->vertexFormat = static_cast<render::VertexFormat>(entry.vertexFormat);
+            geometry->indexCount = entry.indexCount;
+            geometry->indexFormat = static_cast<render::IndexFormat>(entry.indexFormat);
+            if (!fits(entry.nameOffset, entry.nameLength)
+                || !fits(entry.submeshOffset, sizeof(render::Submesh) * static_cast<uint64_t>(entry.submeshCount))
+                || !fits(entry.materialOffset, sizeof(int32_t) * static_cast<uint64_t>(entry.materialCount))
+                || !fits(entry.lodOffset, sizeof(render::MeshLod) * static_cast<uint64_t>(entry.lodCount))
+                || !fits(entry.vertexOffset, geometry->GetVertexBytes())
+                || !fits(entry.indexOffset, geometry->GetIndexBytes())) {
+                return false;
+            }
+            // the streams are read in place, the writer aligns them
+            if (entry.vertexOffset % COOKED_ALIGNMENT != 0 || entry.indexOffset % COOKED_ALIGNMENT != 0) return false;
+
+            ImportedMesh& imported = meshes.emplace_back();
+            imported.name.assign(reinterpret_cast<const char*>(data + entry.nameOffset), entry.nameLength);
+            imported.materials.resize(entry.materialCount);
+            for (uint32_t slot = 0; slot < entry.materialCount; slot++) {
+                int32_t material;
+                memcpy(&material, data + entry.materialOffset + sizeof(int32_t) * slot, sizeof(material));
+                imported.materials[slot] = material;
+            }
+
+            geometry->submeshes.resize(entry.submeshCount);
+            memcpy(geometry->submeshes.data(), data + entry.submeshOffset, sizeof(render::Submesh) * entry.submeshCount);
+            for (const render::Submesh& submesh : geometry->submeshes) {
+                if (submesh.firstIndex > entry.indexCount || submesh.indexCount > entry.indexCount - submesh.firstIndex) return false;
+                if (submesh.materialSlot >= entry.materialCount) return false;
+            }
+            geometry->lods.resize(entry.lodCount);
+            memcpy(geometry->lods.data(), data + entry.lodOffset, sizeof(render::MeshLod) * entry.lodCount);
+            for (const render::MeshLod& lod : geometry->lods) {
+                if (lod.firstIndex > entry.indexCount || lod.indexCount > entry.indexCount - lod.firstIndex) return false;
+            }
+            // the streams are used in place, the mapping lives as long as the geometry
+            if (geometry->vertexFormat == render::VertexFormat::UNorm16) {
+                geometry->positions = nullptr;
+                geometry->quantizedPositions = reinterpret_cast<const uint16_t*>(data + entry.vertexOffset);
+            } else {
+                geometry->positions = reinterpret_cast<const math::PackedVector3*>(data + entry.vertexOffset);
+            }
+            geometry->indices = data + entry.indexOffset;
+            // a stale or damaged entry whose hash still matches would otherwise draw the next mesh's vertices in the pool
+            if (!geometry->IndicesInRange()) return false;
+            geometry->owner = file;
+            geometry->hasBounds = true;
+            memcpy(geometry->boundsMin, entry.boundsMin, sizeof(entry.boundsMin));
+            memcpy(geometry->boundsMax, entry.boundsMax, sizeof(entry.boundsMax));
+            imported.geometry = geometry;
+        }
+
+        out = std::move(meshes);
+        return true;
+    }
+
+    void SetMeshCacheDirectory(const std::string& nativePath) {
+        std::lock_guard lock(cacheMutex);
+        cacheDirectory = nativePath;
+    }
+
+    std::string GetMeshCacheDirectory() {
+        std::lock_guard lock(cacheMutex);
+        if (cacheDirectory.empty()) {
+            char* prefPath = SDL_GetPrefPath("MANIFOLD", "MANIFOLDEngineTest");
+            if (prefPath) {
+                cacheDirectory = std::string(prefPath) + "meshcache/";
+                SDL_free(prefPath);
+            }
+        }
+        return cacheDirectory;
+    }
+
+    std::vector<ImportedMesh> DecodeGltfCached(const std::string& path, const ImportOptions& options) {
+        MappedFilePtr source = MappedFile::Open(path);
+        std::string directory = GetMeshCacheDirectory();
+        if (!source || directory.empty()) return DecodeGltf(path, options);
+
+        uint64_t hash = util::HashBytes(source->GetData(), source->GetSize());
+        // a .gltf's geometry lives in its .bin files, an edited buffer has to miss as well
+        for (const std::string& bufferPath : GetGltfExternalBuffers(*source, path)) {
+            MappedFilePtr buffer = MappedFile::Open(bufferPath);
+            if (!buffer) return DecodeGltf(path, options);
+            hash = util::HashCombine(hash, util::HashBytes(buffer->GetData(), buffer->GetSize()));
+        }
+        // the same source imported with different options cooks to a different file
+        uint8_t flags = (options.optimize ? 1 : 0) | (options.generateLods ? 2 : 0) | (options.quantize ? 4 : 0);
+        if (flags != 0) hash = util::HashCombine(hash, util::HashBytes(&flags, sizeof(flags)));
+        std::string cookedPath = fmt::format("{}{:016x}.mesh", directory, hash);
+
+        std::vector<ImportedMesh> meshes;
+        if (MappedFilePtr cooked = MappedFile::OpenNative(cookedPath)) {
+            if (ReadCookedMeshes(cooked, hash, meshes)) {
+                spdlog::info("Loaded {} meshes for {} from the mesh cache", meshes.size(), path);
+                return meshes;
+            }
+            spdlog::warn("Cooked {} is outdated or damaged, recooking", cookedPath);
+        }
+
+        meshes = DecodeGltf(path, options);
+        if (meshes.empty()) return meshes;
+
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (WriteCookedMeshes(cookedPath, hash, meshes)) {
+            spdlog::info("Cooked {} to {}", path, cookedPath);
+        } else {
+            spdlog::warn("Failed to write cooked {}", cookedPath);
+        }
+        return meshes;
+    }
+}
@@ -0,0 +1,36 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef COOKEDMESH_H
+#define COOKEDMESH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GltfImporter.h"
+#include "MappedFile.h"
+
+namespace me::loader {
+    // cooked mesh files hold imported meshes in the exact layout the renderer uploads:
+    // a header, a table of meshes, their names, then per mesh the submesh, material and lod tables
+    // and 16 byte aligned vertex and index streams. all little endian
+    constexpr uint32_t COOKED_MESH_MAGIC = 0x4B43454D;
+    // bump whenever the layout or the importer's output changes, older files are recooked
+    constexpr uint32_t COOKED_MESH_VERSION = 4;
+
+    bool WriteCookedMeshes(const std::string& nativePath, uint64_t sourceHash, const std::vector<ImportedMesh>& meshes);
+    // views the meshes in place, false if the file is damaged, outdated or from another source
+    bool ReadCookedMeshes(const MappedFilePtr& file, uint64_t sourceHash, std::vector<ImportedMesh>& out);
+
+    // native directory cooked files go to, defaults to a meshcache folder in SDL's pref path
+    void SetMeshCacheDirectory(const std::string& nativePath);
+    std::string GetMeshCacheDirectory();
+
+    // DecodeGltf through the cache. the source is hashed, a cooked file with that hash is mapped and used directly,
+    // and on a miss the glTF is decoded and cooked for next time. the options are part of the cache key
+    std::vector<ImportedMesh> DecodeGltfCached(const std::string& path, const ImportOptions& options = {});
+}
+
+#endif //COOKEDMESH_H
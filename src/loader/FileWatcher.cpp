@@ -0,0 +1,111 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "FileWatcher.h"
+
+#include <spdlog/spdlog.h>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace me::loader {
+    // how long the thread sleeps between checks for stopping, and between polls where there's no inotify
+    constexpr int WATCH_INTERVAL_MS = 100;
+
+    FileWatcher::FileWatcher() {
+#ifdef __linux__
+        inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify < 0) {
+            spdlog::error("Failed to start inotify, files won't be watched");
+            return;
+        }
+#endif
+        thread = std::thread(&FileWatcher::WatcherMain, this);
+    }
+
+    FileWatcher::~FileWatcher() {
+        stopping = true;
+        if (thread.joinable()) thread.join();
+#ifdef __linux__
+        if (inotify >= 0) close(inotify);
+#endif
+    }
+
+    bool FileWatcher::Watch(const std::string& nativePath) {
+        // changes are reported under the same spelling the file was watched with
+        std::filesystem::path path(nativePath);
+        std::lock_guard lock(mutex);
+        if (!watched.insert(path.string()).second) return true;
+
+#ifdef __linux__
+        if (inotify < 0) return false;
+        std::string directory = path.parent_path().string();
+        // only once the writer is done with the file, a file that was just created may still be empty
+        int descriptor = inotify_add_watch(inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (descriptor < 0) {
+            spdlog::error("Failed to watch {}", directory);
+            watched.erase(path.string());
+            return false;
+        }
+        directories[descriptor] = directory + "/";
+#else
+        std::error_code error;
+        writeTimes[path.string()] = std::filesystem::last_write_time(path, error);
+        if (error) {
+            spdlog::error("Failed to watch {}: {}", path.string(), error.message());
+            watched.erase(path.string());
+            writeTimes.erase(path.string());
+            return false;
+        }
+#endif
+        return true;
+    }
+
+    void FileWatcher::TakeChanged(std::vector<std::string>& out) {
+        std::lock_guard lock(mutex);
+        out.insert(out.end(), changed.begin(), changed.end());
+        changed.clear();
+    }
+
+    void FileWatcher::WatcherMain() {
+#ifdef __linux__
+        alignas(inotify_event) char buffer[4096];
+        while (!stopping) {
+            pollfd descriptor = { inotify, POLLIN, 0 };
+            if (poll(&descriptor, 1, WATCH_INTERVAL_MS) <= 0) continue;
+
+            ssize_t length;
+            while ((length = read(inotify, buffer, sizeof(buffer))) > 0) {
+                std::lock_guard lock(mutex);
+                for (char* cursor = buffer; cursor < buffer + length;) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(cursor);
+                    cursor += sizeof(inotify_event) + event->len;
+
+                    auto directory = directories.find(event->wd);
+                    if (event->len == 0 || directory == directories.end()) continue;
+                    // the whole directory is watched, only the files asked for are reported
+                    std::string path = directory->second + event->name;
+                    if (watched.contains(path)) changed.insert(path);
+                }
+            }
+        }
+#else
+        while (!stopping) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(WATCH_INTERVAL_MS));
+
+            std::lock_guard lock(mutex);
+            for (auto& [path, writeTime] : writeTimes) {
+                std::error_code error;
+                auto current = std::filesystem::last_write_time(path, error);
+                if (error || current == writeTime) continue;
+                writeTime = current;
+                changed.insert(path);
+            }
+        }
+#endif
+    }
+}
@@ -0,0 +1,52 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef FILEWATCHER_H
+#define FILEWATCHER_H
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace me::loader {
+    // reports native files that were written, on its own thread.
+    // linux watches the files' directories with inotify, since editors often save by replacing the file.
+    // elsewhere the files' modification times are polled
+    class FileWatcher {
+        private:
+        std::thread thread;
+        std::atomic<bool> stopping = false;
+
+        std::mutex mutex;
+        std::unordered_set<std::string> watched;
+        // changes since the last TakeChanged, each file once
+        std::unordered_set<std::string> changed;
+
+#ifdef __linux__
+        int inotify = -1;
+        // watch descriptor -> directory, with a trailing separator
+        std::unordered_map<int, std::string> directories;
+#else
+        std::unordered_map<std::string, std::filesystem::file_time_type> writeTimes;
+#endif
+
+        void WatcherMain();
+
+        public:
+        FileWatcher();
+        ~FileWatcher();
+
+        // false and logged if it can't be watched
+        bool Watch(const std::string& nativePath);
+        // moves the files changed since the last call into out
+        void TakeChanged(std::vector<std::string>& out);
+    };
+}
+
+#endif //FILEWATCHER_H
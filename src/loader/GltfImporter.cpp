@@ -0,0 +1,636 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "GltfImporter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "MappedFile.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+
+namespace me::loader {
+    enum ComponentType {
+        COMPONENT_BYTE = 5120,
+        COMPONENT_UNSIGNED_BYTE = 5121,
+        COMPONENT_SHORT = 5122,
+        COMPONENT_UNSIGNED_SHORT = 5123,
+        COMPONENT_INT = 5124,
+        COMPONENT_UNSIGNED_INT = 5125,
+        COMPONENT_FLOAT = 5126,
+        COMPONENT_DOUBLE = 5130
+    };
+
+    constexpr int MODE_TRIANGLES = 4;
+
+    constexpr uint32_t GLB_MAGIC = 0x46546C67;
+    constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+    constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;
+
+    static_assert(sizeof(math::PackedVector3) == 3 * sizeof(float), "positions are viewed in place as float3");
+
+    // just the parts of a glTF the importer reads, views point into mapped or decoded buffers
+    struct GltfBufferView {
+        int buffer;
+        size_t byteOffset;
+        size_t byteLength;
+        size_t byteStride;
+    };
+
+    struct GltfAccessor {
+        int bufferView;
+        size_t byteOffset;
+        int componentType;
+        bool normalized;
+        size_t count;
+        uint32_t components;
+
+        bool sparse;
+        size_t sparseCount;
+        int sparseIndexView;
+        size_t sparseIndexOffset;
+        int sparseIndexType;
+        int sparseValueView;
+        size_t sparseValueOffset;
+    };
+
+    struct GltfPrimitive {
+        int position;
+        int indices;
+        int material;
+        int mode;
+    };
+
+    struct GltfMesh {
+        std::string name;
+        std::vector<GltfPrimitive> primitives;
+    };
+
+    // keeps every mapped file and decoded buffer of a document alive
+    struct GltfStorage {
+        std::vector<MappedFilePtr> files;
+        std::vector<std::vector<uint8_t>> decoded;
+    };
+
+    struct GltfDocument {
+        std::shared_ptr<GltfStorage> storage;
+        std::vector<std::span<const uint8_t>> buffers;
+        std::vector<GltfBufferView> views;
+        std::vector<GltfAccessor> accessors;
+        std::vector<GltfMesh> meshes;
+    };
+
+    static size_t GetComponentSize(int componentType) {
+        switch (componentType) {
+            case COMPONENT_BYTE:
+            case COMPONENT_UNSIGNED_BYTE:
+                return 1;
+            case COMPONENT_SHORT:
+            case COMPONENT_UNSIGNED_SHORT:
+                return 2;
+            case COMPONENT_INT:
+            case COMPONENT_UNSIGNED_INT:
+            case COMPONENT_FLOAT:
+                return 4;
+            case COMPONENT_DOUBLE:
+                return 8;
+            default:
+                return 0;
+        }
+    }
+
+    static uint32_t GetComponentCount(const std::string& type) {
+        if (type == "SCALAR") return 1;
+        if (type == "VEC2") return 2;
+        if (type == "VEC3") return 3;
+        if (type == "VEC4" || type == "MAT2") return 4;
+        if (type == "MAT3") return 9;
+        if (type == "MAT4") return 16;
+        return 0;
+    }
+
+    static bool DecodeBase64(std::string_view text, std::vector<uint8_t>& out) {
+        auto decode = [](char c) -> int {
+            if (c >= 'A' && c <= 'Z') return c - 'A';
+            if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+            if (c >= '0' && c <= '9') return c - '0' + 52;
+            if (c == '+' || c == '-') return 62;
+            if (c == '/' || c == '_') return 63;
+            return -1;
+        };
+
+        out.clear();
+        out.reserve(text.size() / 4 * 3);
+        uint32_t bits = 0;
+        int count = 0;
+        for (char c : text) {
+            if (c == '=') break;
+            int value = decode(c);
+            if (value < 0) return false;
+            bits = (bits << 6) | value;
+            count += 6;
+            if (count >= 8) {
+                count -= 8;
+                out.push_back(static_cast<uint8_t>(bits >> count));
+            }
+        }
+        return true;
+    }
+
+    static bool LoadBuffers(const nlohmann::json& json, const std::string& path, std::span<const uint8_t> binChunk, GltfDocument& document) {
+        std::string directory = path.substr(0, path.find_last_of('/') + 1);
+
+        for (const nlohmann::json& buffer : json.value("buffers", nlohmann::json::array())) {
+            std::string uri = buffer.value("uri", "");
+            size_t byteLength = buffer.value("byteLength", size_t(0));
+
+            std::span<const uint8_t> bytes;
+            if (uri.empty()) {
+                // the glb's own BIN chunk
+                bytes = binChunk;
+            } else if (uri.starts_with("data:")) {
+                size_t comma = uri.find(',');
+                std::vector<uint8_t>& decoded = document.storage->decoded.emplace_back();
+                if (comma == std::string::npos || !DecodeBase64(std::string_view(uri).substr(comma + 1), decoded)) {
+                    spdlog::error("Bad data uri in {}", path);
+                    return false;
+                }
+                bytes = decoded;
+            } else {
+                MappedFilePtr file = MappedFile::Open(directory + uri);
+                if (!file) {
+                    spdlog::error("Failed to open buffer {} of {}", uri, path);
+                    return false;
+                }
+                document.storage->files.push_back(file);
+                bytes = { file->GetData(), file->GetSize() };
+            }
+
+            if (bytes.size() < byteLength) {
+                spdlog::error("Buffer of {} is {} bytes, expected {}", path, bytes.size(), byteLength);
+                return false;
+            }
+            document.buffers.push_back(bytes.subspan(0, byteLength));
+        }
+        return true;
+    }
+
+    static void ParseDocument(const nlohmann::json& json, GltfDocument& document) {
+        for (const nlohmann::json& view : json.value("bufferViews", nlohmann::json::array())) {
+            document.views.push_back({
+                view.value("buffer", -1),
+                view.value("byteOffset", size_t(0)),
+                view.value("byteLength", size_t(0)),
+                view.value("byteStride", size_t(0))
+            });
+        }
+
+        for (const nlohmann::json& accessor : json.value("accessors", nlohmann::json::array())) {
+            GltfAccessor parsed = {
+                accessor.value("bufferView", -1),
+                accessor.value("byteOffset", size_t(0)),
+                accessor.value("componentType", 0),
+                accessor.value("normalized", false),
+                accessor.value("count", size_t(0)),
+                GetComponentCount(accessor.value("type", "")),
+                false, 0, -1, 0, 0, -1, 0
+            };
+
+            auto sparse = accessor.find("sparse");
+            if (sparse != accessor.end()) {
+                nlohmann::json indices = sparse->value("indices", nlohmann::json::object());
+                nlohmann::json values = sparse->value("values", nlohmann::json::object());
+                parsed.sparse = true;
+                parsed.sparseCount = sparse->value("count", size_t(0));
+                parsed.sparseIndexView = indices.value("bufferView", -1);
+                parsed.sparseIndexOffset = indices.value("byteOffset", size_t(0));
+                parsed.sparseIndexType = indices.value("componentType", 0);
+                parsed.sparseValueView = values.value("bufferView", -1);
+                parsed.sparseValueOffset = values.value("byteOffset", size_t(0));
+            }
+            document.accessors.push_back(parsed);
+        }
+
+        for (const nlohmann::json& mesh : json.value("meshes", nlohmann::json::array())) {
+            GltfMesh& parsed = document.meshes.emplace_back();
+            parsed.name = mesh.value("name", "");
+            for (const nlohmann::json& primitive : mesh.value("primitives", nlohmann::json::array())) {
+                const nlohmann::json& attributes = primitive.value("attributes", nlohmann::json::object());
+                parsed.primitives.push_back({
+                    attributes.value("POSITION", -1),
+                    primitive.value("indices", -1),
+                    primitive.value("material", -1),
+                    primitive.value("mode", MODE_TRIANGLES)
+                });
+            }
+        }
+    }
+
+    // one component of any accessor component type as a float, normalized types map to [0, 1] or [-1, 1]
+    static float ReadComponent(const uint8_t* data, int componentType, bool normalized) {
+        switch (componentType) {
+            case COMPONENT_BYTE: {
+                int8_t value;
+                memcpy(&value, data, sizeof(value));
+                return normalized ? std::max(value / 127.0f, -1.0f) : value;
+            }
+            case COMPONENT_UNSIGNED_BYTE: {
+                uint8_t value = *data;
+                return normalized ? value / 255.0f : value;
+            }
+            case COMPONENT_SHORT: {
+                int16_t value;
+                memcpy(&value, data, sizeof(value));
+                return normalized ? std::max(value / 32767.0f, -1.0f) : value;
+            }
+            case COMPONENT_UNSIGNED_SHORT: {
+                uint16_t value;
+                memcpy(&value, data, sizeof(value));
+                return normalized ? value / 65535.0f : value;
+            }
+            case COMPONENT_INT: {
+                int32_t value;
+                memcpy(&value, data, sizeof(value));
+                return static_cast<float>(value);
+            }
+            case COMPONENT_UNSIGNED_INT: {
+                uint32_t value;
+                memcpy(&value, data, sizeof(value));
+                return static_cast<float>(value);
+            }
+            case COMPONENT_FLOAT: {
+                float value;
+                memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            case COMPONENT_DOUBLE: {
+                double value;
+                memcpy(&value, data, sizeof(value));
+                return static_cast<float>(value);
+            }
+            default:
+                return 0.0f;
+        }
+    }
+
+    static uint32_t ReadIndex(const uint8_t* data, int componentType) {
+        switch (componentType) {
+            case COMPONENT_UNSIGNED_BYTE:
+                return *data;
+            case COMPONENT_UNSIGNED_SHORT: {
+                uint16_t value;
+                memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            case COMPONENT_UNSIGNED_INT: {
+                uint32_t value;
+                memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            default:
+                return static_cast<uint32_t>(ReadComponent(data, componentType, false));
+        }
+    }
+
+    // pointer to the first element of a view and the distance between elements, or nullptr if it doesn't fit the buffer
+    static const uint8_t* ResolveView(const GltfDocument& document, int viewId, size_t byteOffset, size_t count, size_t elementSize,
+                                      size_t& stride) {
+        if (viewId < 0 || viewId >= static_cast<int>(document.views.size()) || elementSize == 0) return nullptr;
+
+        const GltfBufferView& view = document.views[viewId];
+        if (view.buffer < 0 || view.buffer >= static_cast<int>(document.buffers.size())) return nullptr;
+        std::span<const uint8_t> buffer = document.buffers[view.buffer];
+
+        // byteStride 0 means tightly packed
+        stride = view.byteStride != 0 ? view.byteStride : elementSize;
+        // every size comes from the file, so none of the sums may wrap
+        if (count > 1 && count - 1 > (SIZE_MAX - elementSize) / stride) return nullptr;
+        size_t span = count == 0 ? 0 : stride * (count - 1) + elementSize;
+        if (byteOffset > view.byteLength || span > view.byteLength - byteOffset) return nullptr;
+        if (view.byteOffset > buffer.size() || view.byteLength > buffer.size() - view.byteOffset) return nullptr;
+
+        return buffer.data() + view.byteOffset + byteOffset;
+    }
+
+    // calls visit(element, components) for every element of an accessor, sparse substitutions are visited after the base values
+    template <typename Visit>
+    static bool VisitAccessor(const GltfDocument& document, const GltfAccessor& accessor, Visit visit) {
+        size_t elementSize = GetComponentSize(accessor.componentType) * accessor.components;
+        if (elementSize == 0) return false;
+
+        if (accessor.bufferView >= 0) {
+            size_t stride;
+            const uint8_t* data = ResolveView(document, accessor.bufferView, accessor.byteOffset, accessor.count, elementSize, stride);
+            if (data == nullptr) return false;
+            for (size_t i = 0; i < accessor.count; i++) visit(i, data + i * stride);
+        } else {
+            // no view means zeros, normally only used together with sparse values
+            std::vector<uint8_t> zeros(elementSize);
+            for (size_t i = 0; i < accessor.count; i++) visit(i, zeros.data());
+        }
+
+        if (accessor.sparse) {
+            size_t indexSize = GetComponentSize(accessor.sparseIndexType);
+            size_t indexStride, valueStride;
+            const uint8_t* indices = ResolveView(document, accessor.sparseIndexView, accessor.sparseIndexOffset, accessor.sparseCount, indexSize, indexStride);
+            const uint8_t* values = ResolveView(document, accessor.sparseValueView, accessor.sparseValueOffset, accessor.sparseCount, elementSize, valueStride);
+            if (indices == nullptr || values == nullptr) return false;
+
+            for (size_t i = 0; i < accessor.sparseCount; i++) {
+                uint32_t element = ReadIndex(indices + i * indexStride, accessor.sparseIndexType);
+                if (element < accessor.count) visit(element, values + i * valueStride);
+            }
+        }
+        return true;
+    }
+
+    // the accessor's data as it sits in the buffer, if it's tightly packed, aligned and not sparse
+    static const uint8_t* ViewInPlace(const GltfDocument& document, const GltfAccessor& accessor) {
+        if (accessor.sparse || accessor.bufferView < 0) return nullptr;
+
+        size_t elementSize = GetComponentSize(accessor.componentType) * accessor.components;
+        size_t stride;
+        const uint8_t* data = ResolveView(document, accessor.bufferView, accessor.byteOffset, accessor.count, elementSize, stride);
+        if (data == nullptr || stride != elementSize) return nullptr;
+        if (reinterpret_cast<uintptr_t>(data) % GetComponentSize(accessor.componentType) != 0) return nullptr;
+        return data;
+    }
+
+    static bool ReadPositions(const GltfDocument& document, const GltfAccessor& accessor, std::vector<math::PackedVector3>& out) {
+        if (accessor.components != 3) return false;
+
+        size_t base = out.size();
+        out.resize(base + accessor.count);
+        size_t componentSize = GetComponentSize(accessor.componentType);
+        return VisitAccessor(document, accessor, [&](size_t element, const uint8_t* data) {
+            out[base + element] = math::PackedVector3(
+                ReadComponent(data, accessor.componentType, accessor.normalized),
+                ReadComponent(data + componentSize, accessor.componentType, accessor.normalized),
+                ReadComponent(data + componentSize * 2, accessor.componentType, accessor.normalized));
+        });
+    }
+
+    // fails on any index past the primitive's vertexCount vertices, everything after import indexes vertex arrays with them
+    static bool ReadIndices(const GltfDocument& document, const GltfAccessor& accessor, uint32_t baseVertex, uint32_t vertexCount,
+                            std::vector<uint32_t>& out) {
+        if (accessor.components != 1) return false;
+
+        size_t base = out.size();
+        out.resize(base + accessor.count);
+        bool inRange = true;
+        bool read = VisitAccessor(document, accessor, [&](size_t element, const uint8_t* data) {
+            uint32_t index = ReadIndex(data, accessor.componentType);
+            if (index >= vertexCount) inRange = false;
+            out[base + element] = baseVertex + index;
+        });
+        return read && inRange;
+    }
+
+    static bool IsDrawable(const GltfDocument& document, const GltfPrimitive& primitive) {
+        return primitive.mode == MODE_TRIANGLES && primitive.position >= 0 && primitive.position < static_cast<int>(document.accessors.size())
+               && primitive.indices < static_cast<int>(document.accessors.size());
+    }
+
+    // a single primitive with float3 positions and 16/32 bit indices is viewed straight out of the file
+    static bool ViewGeometry(const GltfDocument& document, const GltfPrimitive& primitive, render::MeshGeometry& geometry) {
+        if (primitive.indices < 0) return false;
+        const GltfAccessor& positions = document.accessors[primitive.position];
+        const GltfAccessor& indices = document.accessors[primitive.indices];
+        if (positions.componentType != COMPONENT_FLOAT || positions.components != 3 || indices.components != 1) return false;
+        if (indices.componentType != COMPONENT_UNSIGNED_SHORT && indices.componentType != COMPONENT_UNSIGNED_INT) return false;
+
+        const uint8_t* positionData = ViewInPlace(document, positions);
+        const uint8_t* indexData = ViewInPlace(document, indices);
+        if (positionData == nullptr || indexData == nullptr) return false;
+        geometry.positions = reinterpret_cast<const math::PackedVector3*>(positionData);
+        geometry.vertexCount = static_cast<uint32_t>(positions.count);
+        geometry.indices = indexData;
+        geometry.indexCount = static_cast<uint32_t>(indices.count);
+        geometry.indexFormat = indices.componentType == COMPONENT_UNSIGNED_INT ? render::IndexFormat::UInt32 : render::IndexFormat::UInt16;
+        // the decode path reports it
+        if (!geometry.IndicesInRange()) return false;
+        geometry.submeshes = { { 0, geometry.indexCount, 0 } };
+        geometry.owner = document.storage;
+        return true;
+    }
+
+    // merges every primitive into owned buffers, indices are rebased onto the merged vertices
+    static bool DecodeGeometry(const GltfDocument& document, const GltfMesh& mesh, const ImportOptions& options,
+                               std::vector<int>& materials, render::MeshGeometry& geometry) {
+        struct Decoded {
+            std::vector<math::PackedVector3> positions;
+            std::vector<uint16_t> indices16;
+            std::vector<uint32_t> indices32;
+            std::vector<uint16_t> quantized;
+        };
+        auto decoded = std::make_shared<Decoded>();
+        std::vector<math::PackedVector3>& positions = decoded->positions;
+        std::vector<uint32_t>& indices = decoded->indices32;
+
+        for (const GltfPrimitive& primitive : mesh.primitives) {
+            if (!IsDrawable(document, primitive)) continue;
+
+            uint32_t baseVertex = static_cast<uint32_t>(positions.size());
+            uint32_t firstIndex = static_cast<uint32_t>(indices.size());
+            if (!ReadPositions(document, document.accessors[primitive.position], positions)) {
+                spdlog::error("Bad POSITION accessor in {}", mesh.name);
+                positions.resize(baseVertex);
+                continue;
+            }
+
+            if (primitive.indices >= 0) {
+                if (!ReadIndices(document, document.accessors[primitive.indices], baseVertex, static_cast<uint32_t>(positions.size()) - baseVertex, indices)) {
+                    spdlog::error("Bad index accessor in {}", mesh.name);
+                    positions.resize(baseVertex);
+                    indices.resize(firstIndex);
+                    continue;
+                }
+            } else {
+                for (uint32_t vertex = baseVertex; vertex < positions.size(); vertex++) indices.push_back(vertex);
+            }
+
+            auto slot = std::find(materials.begin(), materials.end(), primitive.material);
+            if (slot == materials.end()) slot = materials.insert(materials.end(), primitive.material);
+
+            geometry.submeshes.push_back({ firstIndex, static_cast<uint32_t>(indices.size()) - firstIndex, static_cast<uint32_t>(slot - materials.begin()) });
+        }
+        if (geometry.submeshes.empty()) return false;
+
+        if (options.optimize) {
+            MeshOptimizeStats stats = OptimizeMesh(positions, indices, geometry.submeshes);
+            spdlog::info("Optimized {}: {} -> {} vertices, acmr {:.3f} -> {:.3f}, atvr {:.3f} -> {:.3f}", mesh.name,
+                         stats.verticesBefore, stats.verticesAfter, stats.before.acmr, stats.after.acmr, stats.before.atvr, stats.after.atvr);
+        }
+
+        if (options.generateLods) {
+            BuildLodChain(positions, indices, geometry.lods);
+            for (size_t level = 1; level < geometry.lods.size() && options.optimize; level++) {
+                OptimizeVertexCache(indices.data() + geometry.lods[level].firstIndex, geometry.lods[level].indexCount,
+                                    static_cast<uint32_t>(positions.size()));
+            }
+            spdlog::info("Built {} levels for {}, coarsest has {} of {} triangles", geometry.lods.size(), mesh.name,
+                         geometry.lods.back().indexCount / 3, geometry.lods[0].indexCount / 3);
+        }
+
+        geometry.positions = positions.data();
+        geometry.vertexCount = static_cast<uint32_t>(positions.size());
+        geometry.indexCount = static_cast<uint32_t>(indices.size());
+
+        if (options.quantize) {
+            ComputeBounds(geometry);
+            QuantizePositions(positions, geometry.boundsMin, geometry.boundsMax, decoded->quantized);
+            geometry.positions = nullptr;
+            geometry.quantizedPositions = decoded->quantized.data();
+            geometry.vertexFormat = render::VertexFormat::UNorm16;
+            positions.clear();
+            positions.shrink_to_fit();
+        }
+
+        // 0xFFFF stays free, some backends always treat it as a strip restart
+        if (geometry.vertexCount < 0xFFFF) {
+            decoded->indices16.assign(indices.begin(), indices.end());
+            indices.clear();
+            indices.shrink_to_fit();
+            geometry.indices = decoded->indices16.data();
+            geometry.indexFormat = render::IndexFormat::UInt16;
+        } else {
+            geometry.indices = indices.data();
+            geometry.indexFormat = render::IndexFormat::UInt32;
+        }
+        geometry.owner = decoded;
+        return true;
+    }
+
+    static void DecodeMeshes(const GltfDocument& document, const std::string& path, const ImportOptions& options, std::vector<ImportedMesh>& out) {
+        for (size_t meshIndex = 0; meshIndex < document.meshes.size(); meshIndex++) {
+            const GltfMesh& mesh = document.meshes[meshIndex];
+            for (const GltfPrimitive& primitive : mesh.primitives) {
+                if (primitive.mode != MODE_TRIANGLES) spdlog::warn("Skipping non triangle primitive in {}", path);
+            }
+
+            ImportedMesh imported;
+            imported.name = mesh.name.empty() ? fmt::format("{}#{}", path, meshIndex) : mesh.name;
+
+            auto geometry = std::make_shared<render::MeshGeometry>();
+            bool single = !options.optimize && !options.generateLods && !options.quantize && mesh.primitives.size() == 1 && IsDrawable(document, mesh.primitives[0]);
+            if (single && ViewGeometry(document, mesh.primitives[0], *geometry)) {
+                imported.materials.push_back(mesh.primitives[0].material);
+            } else if (!DecodeGeometry(document, mesh, options, imported.materials, *geometry)) {
+                continue;
+            }
+
+            imported.geometry = geometry;
+            out.push_back(std::move(imported));
+        }
+    }
+
+    void CreateMeshes(std::vector<ImportedMesh>& meshes) {
+        // the geometry is registered for the mesh and dropped together with it
+        auto deleter = [](asset::Mesh* mesh) {
+            render::UnregisterMeshGeometry(mesh);
+            delete mesh;
+        };
+
+        for (ImportedMesh& imported : meshes) {
+            if (imported.mesh) continue;
+
+            // the engine mesh is only a handle here, its own buffers stay empty and the renderer reads the geometry
+            imported.mesh = asset::MeshPtr(new asset::Mesh(std::vector<math::PackedVector3>(), std::vector<uint16_t>()), deleter);
+            render::RegisterMeshGeometry(imported.mesh.get(), imported.geometry);
+        }
+    }
+
+    // a .gltf is all json, a .glb is a 12 byte header then chunks of { length, type, data } padded to 4 bytes
+    static void SplitChunks(const MappedFile& file, std::span<const uint8_t>& json, std::span<const uint8_t>& binChunk) {
+        const uint8_t* data = file.GetData();
+        size_t size = file.GetSize();
+        json = { data, size };
+        binChunk = {};
+
+        uint32_t magic = 0;
+        if (size >= 12) memcpy(&magic, data, sizeof(magic));
+        if (magic != GLB_MAGIC) return;
+
+        json = {};
+        size_t offset = 12;
+        while (offset + 8 <= size) {
+            uint32_t chunkLength, chunkType;
+            memcpy(&chunkLength, data + offset, sizeof(chunkLength));
+            memcpy(&chunkType, data + offset + 4, sizeof(chunkType));
+            offset += 8;
+            if (chunkLength > size - offset) break;
+
+            if (chunkType == GLB_CHUNK_JSON) json = { data + offset, chunkLength };
+            else if (chunkType == GLB_CHUNK_BIN && binChunk.empty()) binChunk = { data + offset, chunkLength };
+            offset += (static_cast<size_t>(chunkLength) + 3) & ~size_t(3);
+        }
+    }
+
+    std::vector<std::string> GetGltfExternalBuffers(const MappedFile& file, const std::string& path) {
+        std::vector<std::string> buffers;
+        std::span<const uint8_t> json, binChunk;
+        SplitChunks(file, json, binChunk);
+
+        nlohmann::json parsed = nlohmann::json::parse(json.begin(), json.end(), nullptr, false);
+        if (parsed.is_discarded() || !parsed.is_object()) return buffers;
+
+        std::string directory = path.substr(0, path.find_last_of('/') + 1);
+        try {
+            for (const nlohmann::json& buffer : parsed.value("buffers", nlohmann::json::array())) {
+                std::string uri = buffer.value("uri", "");
+                if (!uri.empty() && !uri.starts_with("data:")) buffers.push_back(directory + uri);
+            }
+        } catch (const nlohmann::json::exception&) {
+            // the import itself reports it
+        }
+        return buffers;
+    }
+
+    std::vector<ImportedMesh> DecodeGltf(const std::string& path, const ImportOptions& options) {
+        std::vector<ImportedMesh> meshes;
+
+        MappedFilePtr file = MappedFile::Open(path);
+        if (!file) {
+            spdlog::error("Failed to open glTF: {}", path);
+            return meshes;
+        }
+
+        GltfDocument document;
+        document.storage = std::make_shared<GltfStorage>();
+        document.storage->files.push_back(file);
+
+        std::span<const uint8_t> json, binChunk;
+        SplitChunks(*file, json, binChunk);
+
+        nlohmann::json parsed = nlohmann::json::parse(json.begin(), json.end(), nullptr, false);
+        if (parsed.is_discarded() || !parsed.is_object()) {
+            spdlog::error("Failed to parse glTF: {}", path);
+            return meshes;
+        }
+
+        // value() throws when a field has the wrong type, this runs on loader threads where that would terminate
+        try {
+            if (!LoadBuffers(parsed, path, binChunk, document)) return meshes;
+            ParseDocument(parsed, document);
+        } catch (const nlohmann::json::exception& e) {
+            spdlog::error("Malformed glTF {}: {}", path, e.what());
+            return meshes;
+        }
+        DecodeMeshes(document, path, options, meshes);
+
+        spdlog::info("Decoded {} meshes from {} ({})", meshes.size(), path, file->IsMapped() ? "mapped" : "read");
+        return meshes;
+    }
+
+    std::vector<ImportedMesh> ImportGltf(const std::string& path, const ImportOptions& options) {
+        std::vector<ImportedMesh> meshes = DecodeGltf(path, options);
+        CreateMeshes(meshes);
+        return meshes;
+    }
+}
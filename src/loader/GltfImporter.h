@@ -0,0 +1,50 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef GLTFIMPORTER_H
+#define GLTFIMPORTER_H
+
+#include <string>
+#include <vector>
+
+#include "asset/Mesh.h"
+#include "MappedFile.h"
+#include "../render/MeshGeometry.h"
+
+namespace me::loader {
+    struct ImportOptions {
+        // weld, reorder for the vertex cache and overdraw, then remap for fetch locality.
+        // meshes with any option set are always decoded into owned buffers
+        bool optimize = false;
+        // simplified levels of detail appended after the full mesh's indices, see BuildLodChain
+        bool generateLods = false;
+        // positions stored as 16 bit unorm relative to the mesh bounds (VertexFormat::UNorm16), 8 bytes instead of 12
+        bool quantize = false;
+    };
+
+    struct ImportedMesh {
+        std::string name;
+        // an empty engine mesh, geometry is registered for it until it's destroyed. null until CreateMeshes
+        asset::MeshPtr mesh;
+        render::MeshGeometryPtr geometry;
+        // glTF material index of every slot the submeshes refer to, -1 for primitives without one
+        std::vector<int> materials;
+    };
+
+    // imports every mesh in a .glb or .gltf, the file and its external buffers are memory mapped when they're on disk.
+    // a mesh with one primitive of float3 positions and 16/32 bit indices is viewed in place and keeps the file mapped.
+    // otherwise all triangle primitives are decoded and merged into one vertex/index stream with a submesh each,
+    // indices are 16 bit unless the merged mesh has too many vertices for them
+    std::vector<ImportedMesh> ImportGltf(const std::string& path, const ImportOptions& options = {});
+
+    // the two halves of ImportGltf. decoding touches no engine state and can run on any thread,
+    // CreateMeshes makes the engine meshes and has to run on the main thread
+    std::vector<ImportedMesh> DecodeGltf(const std::string& path, const ImportOptions& options = {});
+    void CreateMeshes(std::vector<ImportedMesh>& meshes);
+
+    // paths of the buffer files a glTF references next to it, as they'd be opened on import. embedded buffers aren't listed
+    std::vector<std::string> GetGltfExternalBuffers(const MappedFile& file, const std::string& path);
+}
+
+#endif //GLTFIMPORTER_H
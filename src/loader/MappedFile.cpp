@@ -0,0 +1,116 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "MappedFile.h"
+
+#include <spdlog/spdlog.h>
+
+#include "fs/FileSystem.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace me::loader {
+    MappedFile::~MappedFile() {
+        Unmap();
+    }
+
+    bool MappedFile::Map(const std::string& nativePath) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(nativePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (view == nullptr) {
+            if (mapping) CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        fileHandle = file;
+        mappingHandle = mapping;
+        data = static_cast<const uint8_t*>(view);
+        size = static_cast<size_t>(fileSize.QuadPart);
+        return true;
+#else
+        int file = open(nativePath.c_str(), O_RDONLY);
+        if (file < 0) return false;
+
+        struct stat info;
+        if (fstat(file, &info) != 0 || info.st_size == 0) {
+            close(file);
+            return false;
+        }
+
+        void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        // the mapping keeps its own reference to the file
+        close(file);
+        if (view == MAP_FAILED) return false;
+
+        // accessors are mostly walked front to back
+        madvise(view, info.st_size, MADV_SEQUENTIAL);
+
+        data = static_cast<const uint8_t*>(view);
+        size = static_cast<size_t>(info.st_size);
+        return true;
+#endif
+    }
+
+    void MappedFile::Unmap() {
+        if (data == nullptr || !fallback.empty()) return;
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+#else
+        munmap(const_cast<uint8_t*>(data), size);
+#endif
+        data = nullptr;
+    }
+
+    std::shared_ptr<MappedFile> MappedFile::OpenNative(const std::string& nativePath) {
+        auto mapped = std::make_shared<MappedFile>();
+        if (!mapped->Map(nativePath)) return nullptr;
+        return mapped;
+    }
+
+    std::shared_ptr<MappedFile> MappedFile::Open(const std::string& path) {
+        vfspp::IFilePtr file = fs::OpenFile(path);
+        if (!file || !file->IsOpened()) return nullptr;
+
+        auto mapped = std::make_shared<MappedFile>();
+
+        // native backends resolve to a real path, anything else (archives, memory) fails to open there and is read instead
+        if (mapped->Map(file->GetFileInfo().AbsolutePath())) {
+            file->Close();
+            return mapped;
+        }
+
+        mapped->fallback.resize(file->Size());
+        if (file->Read(mapped->fallback.data(), mapped->fallback.size()) != mapped->fallback.size()) {
+            spdlog::error("Short read on {}", path);
+            file->Close();
+            return nullptr;
+        }
+        file->Close();
+
+        mapped->data = mapped->fallback.data();
+        mapped->size = mapped->fallback.size();
+        return mapped;
+    }
+}
@@ -0,0 +1,48 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace me::loader {
+    // read only bytes of a file, memory mapped when the file lives on disk and read into memory otherwise
+    class MappedFile {
+        private:
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        std::vector<uint8_t> fallback;
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+
+        bool Map(const std::string& nativePath);
+        void Unmap();
+
+        public:
+        MappedFile() = default;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        // opens a path through the fs layer, nullptr if it can't be opened
+        static std::shared_ptr<MappedFile> Open(const std::string& path);
+        // maps a path on the native file system, bypassing the fs layer
+        static std::shared_ptr<MappedFile> OpenNative(const std::string& nativePath);
+
+        const uint8_t* GetData() const { return data; }
+        size_t GetSize() const { return size; }
+        bool IsMapped() const { return fallback.empty() && data != nullptr; }
+    };
+
+    typedef std::shared_ptr<MappedFile> MappedFilePtr;
+}
+
+#endif //MAPPEDFILE_H
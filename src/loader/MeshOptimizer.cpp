@@ -0,0 +1,328 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace me::loader {
+    // fifo size used for the stats, matches most desktop gpus closely enough
+    constexpr uint32_t ANALYZE_CACHE_SIZE = 16;
+    // lru size Forsyth's scoring models
+    constexpr int FORSYTH_CACHE_SIZE = 32;
+
+    VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, uint32_t vertexCount) {
+        if (indexCount < 3 || vertexCount == 0) return { 0.0f, 0.0f };
+
+        // timestamps instead of a real fifo, a vertex is cached if it was pushed less than cache size misses ago
+        std::vector<uint32_t> pushedAt(vertexCount, 0);
+        uint32_t misses = 0;
+        for (size_t i = 0; i < indexCount; i++) {
+            uint32_t vertex = indices[i];
+            if (pushedAt[vertex] == 0 || misses + 1 - pushedAt[vertex] >= ANALYZE_CACHE_SIZE) {
+                misses++;
+                pushedAt[vertex] = misses;
+            }
+        }
+        return { static_cast<float>(misses) / (indexCount / 3), static_cast<float>(misses) / vertexCount };
+    }
+
+    void WeldVertices(std::vector<math::PackedVector3>& positions, std::vector<uint32_t>& indices) {
+        struct Key {
+            uint32_t bits[3];
+            bool operator==(const Key& other) const { return memcmp(bits, other.bits, sizeof(bits)) == 0; }
+        };
+        struct KeyHash {
+            size_t operator()(const Key& key) const {
+                return (key.bits[0] * 73856093u) ^ (key.bits[1] * 19349663u) ^ (key.bits[2] * 83492791u);
+            }
+        };
+
+        std::unordered_map<Key, uint32_t, KeyHash> unique;
+        unique.reserve(positions.size());
+        std::vector<uint32_t> remap(positions.size());
+        std::vector<math::PackedVector3> welded;
+        welded.reserve(positions.size());
+
+        for (size_t vertex = 0; vertex < positions.size(); vertex++) {
+            float v[3];
+            memcpy(v, &positions[vertex], sizeof(v));
+            Key key;
+            for (int i = 0; i < 3; i++) {
+                // -0 and 0 are the same place
+                float value = v[i] == 0.0f ? 0.0f : v[i];
+                memcpy(&key.bits[i], &value, sizeof(value));
+            }
+
+            auto [found, inserted] = unique.emplace(key, static_cast<uint32_t>(welded.size()));
+            if (inserted) welded.push_back(positions[vertex]);
+            remap[vertex] = found->second;
+        }
+
+        for (uint32_t& index : indices) index = remap[index];
+        positions.swap(welded);
+    }
+
+    static float ForsythVertexScore(int cachePosition, uint32_t remaining) {
+        if (remaining == 0) return -1.0f;
+
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            // the last triangle's vertices get a fixed score so the next one doesn't just repeat them
+            if (cachePosition < 3) {
+                score = 0.75f;
+            } else {
+                float scaler = 1.0f - static_cast<float>(cachePosition - 3) / (FORSYTH_CACHE_SIZE - 3);
+                score = std::pow(scaler, 1.5f);
+            }
+        }
+        // vertices with few triangles left are finished off first
+        return score + 2.0f / std::sqrt(static_cast<float>(remaining));
+    }
+
+    void OptimizeVertexCache(uint32_t* indices, size_t indexCount, uint32_t vertexCount) {
+        size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0) return;
+
+        // triangles of every vertex, the live ones are kept at the front of each list
+        std::vector<uint32_t> remaining(vertexCount, 0);
+        for (size_t i = 0; i < triangleCount * 3; i++) remaining[indices[i]]++;
+        std::vector<uint32_t> offsets(vertexCount + 1, 0);
+        for (uint32_t vertex = 0; vertex < vertexCount; vertex++) offsets[vertex + 1] = offsets[vertex] + remaining[vertex];
+        std::vector<uint32_t> adjacency(triangleCount * 3);
+        {
+            std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < triangleCount * 3; i++) adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        std::vector<int> cachePosition(vertexCount, -1);
+        std::vector<float> vertexScore(vertexCount);
+        for (uint32_t vertex = 0; vertex < vertexCount; vertex++) vertexScore[vertex] = ForsythVertexScore(-1, remaining[vertex]);
+
+        std::vector<float> triangleScore(triangleCount);
+        std::vector<uint8_t> emitted(triangleCount, 0);
+        int64_t best = -1;
+        float bestScore = -1.0f;
+        for (size_t triangle = 0; triangle < triangleCount; triangle++) {
+            const uint32_t* t = indices + triangle * 3;
+            triangleScore[triangle] = vertexScore[t[0]] + vertexScore[t[1]] + vertexScore[t[2]];
+            if (triangleScore[triangle] > bestScore) {
+                bestScore = triangleScore[triangle];
+                best = static_cast<int64_t>(triangle);
+            }
+        }
+
+        std::vector<uint32_t> output;
+        output.reserve(triangleCount * 3);
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> nextCache;
+        cache.reserve(FORSYTH_CACHE_SIZE + 3);
+        nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+        size_t cursor = 0;
+
+        while (output.size() < triangleCount * 3) {
+            if (best < 0) {
+                // nothing in the cache has triangles left, continue from the first one not emitted yet
+                while (emitted[cursor]) cursor++;
+                best = static_cast<int64_t>(cursor);
+            }
+
+            const uint32_t* t = indices + best * 3;
+            uint32_t triangle[3] = { t[0], t[1], t[2] };
+            emitted[best] = 1;
+            output.insert(output.end(), triangle, triangle + 3);
+
+            for (uint32_t vertex : triangle) {
+                uint32_t* begin = adjacency.data() + offsets[vertex];
+                uint32_t* end = begin + remaining[vertex];
+                uint32_t* found = std::find(begin, end, static_cast<uint32_t>(best));
+                if (found != end) {
+                    std::swap(*found, *(end - 1));
+                    remaining[vertex]--;
+                }
+            }
+
+            // the triangle's vertices move to the front, everything else shifts back
+            nextCache.assign(triangle, triangle + 3);
+            for (uint32_t vertex : cache) {
+                if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2]) nextCache.push_back(vertex);
+            }
+
+            for (size_t i = 0; i < nextCache.size(); i++) {
+                uint32_t vertex = nextCache[i];
+                cachePosition[vertex] = i < FORSYTH_CACHE_SIZE ? static_cast<int>(i) : -1;
+                vertexScore[vertex] = ForsythVertexScore(cachePosition[vertex], remaining[vertex]);
+            }
+
+            best = -1;
+            bestScore = -1.0f;
+            for (uint32_t vertex : nextCache) {
+                for (uint32_t i = 0; i < remaining[vertex]; i++) {
+                    uint32_t candidate = adjacency[offsets[vertex] + i];
+                    const uint32_t* c = indices + candidate * 3;
+                    triangleScore[candidate] = vertexScore[c[0]] + vertexScore[c[1]] + vertexScore[c[2]];
+                    if (triangleScore[candidate] > bestScore) {
+                        bestScore = triangleScore[candidate];
+                        best = candidate;
+                    }
+                }
+            }
+
+            if (nextCache.size() > FORSYTH_CACHE_SIZE) nextCache.resize(FORSYTH_CACHE_SIZE);
+            cache.swap(nextCache);
+        }
+
+        memcpy(indices, output.data(), output.size() * sizeof(uint32_t));
+    }
+
+    void OptimizeOverdraw(uint32_t* indices, size_t indexCount, const math::PackedVector3* positions) {
+        size_t triangleCount = indexCount / 3;
+        if (triangleCount < 2) return;
+
+        auto position = [positions](uint32_t vertex, int axis) {
+            return reinterpret_cast<const float*>(&positions[vertex])[axis];
+        };
+
+        // clusters start wherever the cache order already restarts (a triangle missing all 3 vertices),
+        // so moving them around costs almost nothing in cache efficiency
+        std::vector<size_t> clusterStarts;
+        {
+            uint32_t vertexCount = 0;
+            for (size_t i = 0; i < triangleCount * 3; i++) vertexCount = std::max(vertexCount, indices[i] + 1);
+            std::vector<uint32_t> pushedAt(vertexCount, 0);
+            uint32_t misses = 0;
+            for (size_t triangle = 0; triangle < triangleCount; triangle++) {
+                uint32_t triangleMisses = 0;
+                for (int corner = 0; corner < 3; corner++) {
+                    uint32_t vertex = indices[triangle * 3 + corner];
+                    if (pushedAt[vertex] == 0 || misses + 1 - pushedAt[vertex] >= ANALYZE_CACHE_SIZE) {
+                        misses++;
+                        triangleMisses++;
+                        pushedAt[vertex] = misses;
+                    }
+                }
+                if (triangle == 0 || triangleMisses == 3) clusterStarts.push_back(triangle);
+            }
+        }
+        if (clusterStarts.size() < 2) return;
+        clusterStarts.push_back(triangleCount);
+
+        // area weighted centroid of the whole mesh
+        float meshCenter[3] = {};
+        float meshArea = 0.0f;
+        struct Cluster {
+            size_t begin;
+            size_t end;
+            float sortKey;
+        };
+        std::vector<Cluster> clusters;
+        std::vector<float> clusterData((clusterStarts.size() - 1) * 7, 0.0f);
+
+        for (size_t cluster = 0; cluster + 1 < clusterStarts.size(); cluster++) {
+            float* data = &clusterData[cluster * 7];
+            for (size_t triangle = clusterStarts[cluster]; triangle < clusterStarts[cluster + 1]; triangle++) {
+                const uint32_t* t = indices + triangle * 3;
+                float e1[3], e2[3], normal[3];
+                for (int axis = 0; axis < 3; axis++) {
+                    e1[axis] = position(t[1], axis) - position(t[0], axis);
+                    e2[axis] = position(t[2], axis) - position(t[0], axis);
+                }
+                normal[0] = e1[1] * e2[2] - e1[2] * e2[1];
+                normal[1] = e1[2] * e2[0] - e1[0] * e2[2];
+                normal[2] = e1[0] * e2[1] - e1[1] * e2[0];
+                float area = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+                for (int axis = 0; axis < 3; axis++) {
+                    float center = (position(t[0], axis) + position(t[1], axis) + position(t[2], axis)) / 3.0f;
+                    data[axis] += center * area;
+                    data[3 + axis] += normal[axis];
+                    meshCenter[axis] += center * area;
+                }
+                data[6] += area;
+                meshArea += area;
+            }
+        }
+        if (meshArea > 0.0f) {
+            for (float& axis : meshCenter) axis /= meshArea;
+        }
+
+        for (size_t cluster = 0; cluster + 1 < clusterStarts.size(); cluster++) {
+            const float* data = &clusterData[cluster * 7];
+            float length = std::sqrt(data[3] * data[3] + data[4] * data[4] + data[5] * data[5]);
+            float sortKey = 0.0f;
+            if (data[6] > 0.0f && length > 0.0f) {
+                for (int axis = 0; axis < 3; axis++) {
+                    sortKey += (data[axis] / data[6] - meshCenter[axis]) * data[3 + axis] / length;
+                }
+            }
+            clusters.push_back({ clusterStarts[cluster], clusterStarts[cluster + 1], sortKey });
+        }
+
+        // clusters facing away from the center tend to occlude the rest, draw them first
+        std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+        std::vector<uint32_t> output;
+        output.reserve(triangleCount * 3);
+        for (const Cluster& cluster : clusters) {
+            output.insert(output.end(), indices + cluster.begin * 3, indices + cluster.end * 3);
+        }
+        memcpy(indices, output.data(), output.size() * sizeof(uint32_t));
+    }
+
+    void OptimizeVertexFetch(std::vector<math::PackedVector3>& positions, std::vector<uint32_t>& indices) {
+        std::vector<uint32_t> remap(positions.size(), UINT32_MAX);
+        std::vector<math::PackedVector3> ordered;
+        ordered.reserve(positions.size());
+
+        for (uint32_t& index : indices) {
+            if (remap[index] == UINT32_MAX) {
+                remap[index] = static_cast<uint32_t>(ordered.size());
+                ordered.push_back(positions[index]);
+            }
+            index = remap[index];
+        }
+        positions.swap(ordered);
+    }
+
+    void QuantizePositions(const std::vector<math::PackedVector3>& positions, const float boundsMin[3], const float boundsMax[3],
+                           std::vector<uint16_t>& out) {
+        float scale[3];
+        for (int axis = 0; axis < 3; axis++) {
+            float extent = boundsMax[axis] - boundsMin[axis];
+            scale[axis] = extent > 0.0f ? 65535.0f / extent : 0.0f;
+        }
+
+        out.resize(positions.size() * 4);
+        for (size_t vertex = 0; vertex < positions.size(); vertex++) {
+            const float* v = reinterpret_cast<const float*>(&positions[vertex]);
+            for (int axis = 0; axis < 3; axis++) {
+                float quantized = std::round((v[axis] - boundsMin[axis]) * scale[axis]);
+                out[vertex * 4 + axis] = static_cast<uint16_t>(std::clamp(quantized, 0.0f, 65535.0f));
+            }
+            out[vertex * 4 + 3] = 0;
+        }
+    }
+
+    MeshOptimizeStats OptimizeMesh(std::vector<math::PackedVector3>& positions, std::vector<uint32_t>& indices,
+                                   const std::vector<render::Submesh>& submeshes) {
+        MeshOptimizeStats stats = {};
+        stats.verticesBefore = static_cast<uint32_t>(positions.size());
+        stats.before = AnalyzeVertexCache(indices.data(), indices.size(), stats.verticesBefore);
+
+        WeldVertices(positions, indices);
+        for (const render::Submesh& submesh : submeshes) {
+            uint32_t* range = indices.data() + submesh.firstIndex;
+            OptimizeVertexCache(range, submesh.indexCount, static_cast<uint32_t>(positions.size()));
+            OptimizeOverdraw(range, submesh.indexCount, positions.data());
+        }
+        OptimizeVertexFetch(positions, indices);
+
+        stats.verticesAfter = static_cast<uint32_t>(positions.size());
+        stats.after = AnalyzeVertexCache(indices.data(), indices.size(), stats.verticesAfter);
+        return stats;
+    }
+}
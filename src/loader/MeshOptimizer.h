@@ -0,0 +1,48 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef MESHOPTIMIZER_H
+#define MESHOPTIMIZER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../render/MeshGeometry.h"
+
+namespace me::loader {
+    // post transform cache efficiency of an index buffer, measured on a simulated fifo cache.
+    // acmr is misses per triangle (0.5 is ideal for big grids, 3 is worst), atvr is misses per vertex (1 is ideal)
+    struct VertexCacheStats {
+        float acmr;
+        float atvr;
+    };
+
+    struct MeshOptimizeStats {
+        VertexCacheStats before;
+        VertexCacheStats after;
+        uint32_t verticesBefore;
+        uint32_t verticesAfter;
+    };
+
+    VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, uint32_t vertexCount);
+
+    // merges vertices with identical positions and rewrites the indices to match
+    void WeldVertices(std::vector<math::PackedVector3>& positions, std::vector<uint32_t>& indices);
+    // reorders triangles for the post transform cache (Forsyth's linear speed algorithm)
+    void OptimizeVertexCache(uint32_t* indices, size_t indexCount, uint32_t vertexCount);
+    // reorders clusters of cache optimized triangles so outward facing ones come first and cover the rest
+    void OptimizeOverdraw(uint32_t* indices, size_t indexCount, const math::PackedVector3* positions);
+    // renumbers vertices in the order the indices first use them, unused vertices are dropped
+    void OptimizeVertexFetch(std::vector<math::PackedVector3>& positions, std::vector<uint32_t>& indices);
+
+    // 16 bit unorm xyz and a zero pad per vertex (VertexFormat::UNorm16), relative to the bounds
+    void QuantizePositions(const std::vector<math::PackedVector3>& positions, const float boundsMin[3], const float boundsMax[3],
+                           std::vector<uint16_t>& out);
+
+    // weld, cache, overdraw and fetch in order. triangle reordering stays inside each submesh so their ranges stay valid
+    MeshOptimizeStats OptimizeMesh(std::vector<math::PackedVector3>& positions, std::vector<uint32_t>& indices,
+                                   const std::vector<render::Submesh>& submeshes);
+}
+
+#endif //MESHOPTIMIZER_H
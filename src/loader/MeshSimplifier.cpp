@@ -0,0 +1,285 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace me::loader {
+    // border edges get a plane across them this much stronger than a face, so outlines hold their shape
+    constexpr double BORDER_WEIGHT = 10.0;
+    // each level aims for this share of the previous one's triangles
+    constexpr float LOD_REDUCTION = 0.5f;
+    constexpr uint32_t LOD_MIN_TRIANGLES = 64;
+    // a level that doesn't get below this share of the previous one isn't worth a draw key
+    constexpr float LOD_MAX_RATIO = 0.8f;
+
+    // symmetric 4x4 plane quadric, the error at a point is the weighted sum of squared distances to its planes
+    struct Quadric {
+        double a2, b2, c2, ab, ac, bc, ad, bd, cd, d2;
+        double weight;
+
+        void AddPlane(const double normal[3], double distance, double planeWeight) {
+            double a = normal[0], b = normal[1], c = normal[2], d = distance;
+            a2 += a * a * planeWeight; b2 += b * b * planeWeight; c2 += c * c * planeWeight;
+            ab += a * b * planeWeight; ac += a * c * planeWeight; bc += b * c * planeWeight;
+            ad += a * d * planeWeight; bd += b * d * planeWeight; cd += c * d * planeWeight;
+            d2 += d * d * planeWeight;
+        }
+
+        void Add(const Quadric& other) {
+            a2 += other.a2; b2 += other.b2; c2 += other.c2;
+            ab += other.ab; ac += other.ac; bc += other.bc;
+            ad += other.ad; bd += other.bd; cd += other.cd;
+            d2 += other.d2;
+            weight += other.weight;
+        }
+    };
+
+    // mean squared distance of p to the planes of both quadrics
+    static double CollapseCost(const Quadric& q0, const Quadric& q1, const float* p) {
+        Quadric q = q0;
+        q.Add(q1);
+        double x = p[0], y = p[1], z = p[2];
+        double error = q.a2 * x * x + q.b2 * y * y + q.c2 * z * z
+                       + 2.0 * (q.ab * x * y + q.ac * x * z + q.bc * y * z + q.ad * x + q.bd * y + q.cd * z)
+                       + q.d2;
+        return std::max(error, 0.0) / std::max(q.weight, 1e-20);
+    }
+
+    static void Cross(const double a[3], const double b[3], double out[3]) {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    static void TriangleNormal(const float* p0, const float* p1, const float* p2, double out[3]) {
+        double e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+        double e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+        Cross(e1, e2, out);
+    }
+
+    static uint64_t EdgeKey(uint32_t a, uint32_t b) {
+        return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+    }
+
+    std::vector<SimplifiedIndices> SimplifyMesh(const math::PackedVector3* positions, uint32_t vertexCount,
+                                                const uint32_t* indices, size_t indexCount,
+                                                const std::vector<uint32_t>& targetTriangles) {
+        std::vector<SimplifiedIndices> levels;
+        if (vertexCount == 0 || indexCount < 3 || targetTriangles.empty()) return levels;
+
+        auto position = [positions](uint32_t vertex) { return reinterpret_cast<const float*>(&positions[vertex]); };
+
+        // split vertices at the same spot are one vertex to the topology, otherwise every seam opens up
+        std::vector<uint32_t> canonical(vertexCount);
+        {
+            struct KeyHash {
+                size_t operator()(const std::array<uint32_t, 3>& key) const {
+                    return (key[0] * 73856093u) ^ (key[1] * 19349663u) ^ (key[2] * 83492791u);
+                }
+            };
+            std::unordered_map<std::array<uint32_t, 3>, uint32_t, KeyHash> unique;
+            unique.reserve(vertexCount);
+            for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+                std::array<uint32_t, 3> key;
+                memcpy(key.data(), position(vertex), sizeof(key));
+                canonical[vertex] = unique.emplace(key, vertex).first->second;
+            }
+        }
+
+        float boundsMin[3] = { INFINITY, INFINITY, INFINITY };
+        float boundsMax[3] = { -INFINITY, -INFINITY, -INFINITY };
+        std::vector<uint32_t> triangles;
+        triangles.reserve(indexCount);
+        for (size_t i = 0; i + 2 < indexCount; i += 3) {
+            uint32_t a = canonical[indices[i]], b = canonical[indices[i + 1]], c = canonical[indices[i + 2]];
+            if (a == b || b == c || a == c) continue;
+            triangles.insert(triangles.end(), { a, b, c });
+            for (uint32_t vertex : { a, b, c }) {
+                for (int axis = 0; axis < 3; axis++) {
+                    boundsMin[axis] = std::min(boundsMin[axis], position(vertex)[axis]);
+                    boundsMax[axis] = std::max(boundsMax[axis], position(vertex)[axis]);
+                }
+            }
+        }
+        if (triangles.empty()) return levels;
+
+        float radius = 0.0f;
+        for (int axis = 0; axis < 3; axis++) radius += (boundsMax[axis] - boundsMin[axis]) * (boundsMax[axis] - boundsMin[axis]);
+        radius = std::max(std::sqrt(radius) * 0.5f, 1e-12f);
+
+        // face planes weighted by area, plus a perpendicular plane along every border edge
+        std::vector<Quadric> quadrics(vertexCount, Quadric {});
+        std::unordered_map<uint64_t, uint32_t> edgeUses;
+        edgeUses.reserve(triangles.size());
+        for (size_t i = 0; i < triangles.size(); i += 3) {
+            for (int corner = 0; corner < 3; corner++) edgeUses[EdgeKey(triangles[i + corner], triangles[i + (corner + 1) % 3])]++;
+        }
+        for (size_t i = 0; i < triangles.size(); i += 3) {
+            const uint32_t* t = &triangles[i];
+            double normal[3];
+            TriangleNormal(position(t[0]), position(t[1]), position(t[2]), normal);
+            double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            if (length == 0.0) continue;
+            double area = length * 0.5;
+            for (double& axis : normal) axis /= length;
+            const float* p0 = position(t[0]);
+            double distance = -(normal[0] * p0[0] + normal[1] * p0[1] + normal[2] * p0[2]);
+
+            for (int corner = 0; corner < 3; corner++) {
+                quadrics[t[corner]].AddPlane(normal, distance, area);
+                quadrics[t[corner]].weight += area;
+
+                uint32_t a = t[corner], b = t[(corner + 1) % 3];
+                if (edgeUses[EdgeKey(a, b)] != 1) continue;
+                const float* pa = position(a);
+                const float* pb = position(b);
+                double edge[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] };
+                double edgeLength2 = edge[0] * edge[0] + edge[1] * edge[1] + edge[2] * edge[2];
+                double border[3];
+                Cross(edge, normal, border);
+                double borderLength = std::sqrt(border[0] * border[0] + border[1] * border[1] + border[2] * border[2]);
+                if (borderLength == 0.0) continue;
+                for (double& axis : border) axis /= borderLength;
+                double borderDistance = -(border[0] * pa[0] + border[1] * pa[1] + border[2] * pa[2]);
+                quadrics[a].AddPlane(border, borderDistance, edgeLength2 * BORDER_WEIGHT);
+                quadrics[b].AddPlane(border, borderDistance, edgeLength2 * BORDER_WEIGHT);
+            }
+        }
+
+        struct Collapse {
+            double cost;
+            uint32_t from;
+            uint32_t to;
+        };
+        std::vector<uint64_t> edges;
+        std::vector<Collapse> collapses;
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+        std::vector<uint32_t> adjacency;
+        std::vector<uint32_t> collapseTo(vertexCount);
+        std::vector<uint8_t> locked(vertexCount);
+        double maxCost = 0.0;
+        size_t nextTarget = 0;
+
+        auto snapshot = [&] {
+            while (nextTarget < targetTriangles.size() && triangles.size() / 3 <= targetTriangles[nextTarget]) {
+                levels.push_back({ triangles, static_cast<float>(std::sqrt(maxCost) / radius) });
+                nextTarget++;
+            }
+        };
+        snapshot();
+
+        // each pass collapses the cheapest edges whose neighbourhoods don't overlap, then rebuilds the triangles
+        while (nextTarget < targetTriangles.size()) {
+            size_t triangleCount = triangles.size() / 3;
+
+            edges.clear();
+            for (size_t i = 0; i < triangles.size(); i += 3) {
+                for (int corner = 0; corner < 3; corner++) edges.push_back(EdgeKey(triangles[i + corner], triangles[i + (corner + 1) % 3]));
+            }
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+            collapses.clear();
+            for (uint64_t edge : edges) {
+                uint32_t a = static_cast<uint32_t>(edge >> 32), b = static_cast<uint32_t>(edge);
+                double toB = CollapseCost(quadrics[a], quadrics[b], position(b));
+                double toA = CollapseCost(quadrics[a], quadrics[b], position(a));
+                collapses.push_back(toB <= toA ? Collapse { toB, a, b } : Collapse { toA, b, a });
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+            std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+            for (uint32_t vertex : triangles) adjacencyOffsets[vertex + 1]++;
+            for (uint32_t vertex = 0; vertex < vertexCount; vertex++) adjacencyOffsets[vertex + 1] += adjacencyOffsets[vertex];
+            adjacency.resize(triangles.size());
+            {
+                std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+                for (size_t i = 0; i < triangles.size(); i++) adjacency[fill[triangles[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+
+            for (uint32_t vertex = 0; vertex < vertexCount; vertex++) collapseTo[vertex] = vertex;
+            std::fill(locked.begin(), locked.end(), 0);
+
+            // a collapse removes about two triangles, don't run far past the next target in one pass
+            size_t budget = std::max<size_t>(1, (triangleCount - targetTriangles[nextTarget]) / 2);
+            size_t collapsed = 0;
+            for (const Collapse& collapse : collapses) {
+                if (collapsed >= budget) break;
+                if (locked[collapse.from] || locked[collapse.to]) continue;
+
+                // moving from onto to must not turn any remaining triangle around
+                bool flips = false;
+                for (uint32_t i = adjacencyOffsets[collapse.from]; i < adjacencyOffsets[collapse.from + 1] && !flips; i++) {
+                    const uint32_t* t = &triangles[adjacency[i] * 3];
+                    if (t[0] == collapse.to || t[1] == collapse.to || t[2] == collapse.to) continue;
+
+                    const float* before[3] = { position(t[0]), position(t[1]), position(t[2]) };
+                    const float* after[3] = { before[0], before[1], before[2] };
+                    for (int corner = 0; corner < 3; corner++) {
+                        if (t[corner] == collapse.from) after[corner] = position(collapse.to);
+                    }
+                    double n0[3], n1[3];
+                    TriangleNormal(before[0], before[1], before[2], n0);
+                    TriangleNormal(after[0], after[1], after[2], n1);
+                    flips = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2] <= 0.0;
+                }
+                if (flips) continue;
+
+                collapseTo[collapse.from] = collapse.to;
+                quadrics[collapse.to].Add(quadrics[collapse.from]);
+                maxCost = std::max(maxCost, collapse.cost);
+                // everything around the moved vertex is settled for this pass, later checks would see stale triangles
+                for (uint32_t i = adjacencyOffsets[collapse.from]; i < adjacencyOffsets[collapse.from + 1]; i++) {
+                    const uint32_t* t = &triangles[adjacency[i] * 3];
+                    locked[t[0]] = locked[t[1]] = locked[t[2]] = 1;
+                }
+                locked[collapse.to] = 1;
+                collapsed++;
+            }
+            if (collapsed == 0) break;
+
+            size_t write = 0;
+            for (size_t i = 0; i < triangles.size(); i += 3) {
+                uint32_t a = collapseTo[triangles[i]], b = collapseTo[triangles[i + 1]], c = collapseTo[triangles[i + 2]];
+                if (a == b || b == c || a == c) continue;
+                triangles[write++] = a;
+                triangles[write++] = b;
+                triangles[write++] = c;
+            }
+            triangles.resize(write);
+            if (triangles.empty()) break;
+            snapshot();
+        }
+        return levels;
+    }
+
+    void BuildLodChain(const std::vector<math::PackedVector3>& positions, std::vector<uint32_t>& indices,
+                       std::vector<render::MeshLod>& lods) {
+        uint32_t fullIndexCount = static_cast<uint32_t>(indices.size());
+        lods = { { 0, fullIndexCount, 0.0f } };
+
+        std::vector<uint32_t> targets;
+        float target = fullIndexCount / 3 * LOD_REDUCTION;
+        while (target >= LOD_MIN_TRIANGLES && targets.size() + 1 < render::MAX_MESH_LODS) {
+            targets.push_back(static_cast<uint32_t>(target));
+            target *= LOD_REDUCTION;
+        }
+        if (targets.empty()) return;
+
+        std::vector<SimplifiedIndices> levels = SimplifyMesh(positions.data(), static_cast<uint32_t>(positions.size()),
+                                                            indices.data(), fullIndexCount, targets);
+        for (SimplifiedIndices& level : levels) {
+            if (level.indices.size() > lods.back().indexCount * LOD_MAX_RATIO) continue;
+
+            lods.push_back({ static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(level.indices.size()), level.error });
+            indices.insert(indices.end(), level.indices.begin(), level.indices.end());
+        }
+    }
+}
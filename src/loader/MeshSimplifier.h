@@ -0,0 +1,33 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef MESHSIMPLIFIER_H
+#define MESHSIMPLIFIER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../render/MeshGeometry.h"
+
+namespace me::loader {
+    // a simplified index list and its error, relative to the radius of the mesh's bounds
+    struct SimplifiedIndices {
+        std::vector<uint32_t> indices;
+        float error;
+    };
+
+    // quadric error metric edge collapse (Garland and Heckbert). vertices are only ever collapsed onto
+    // an existing neighbour, so every level indexes the original vertices and no new ones are made.
+    // one level is written per target triangle count (descending), it stops early once nothing collapses anymore
+    std::vector<SimplifiedIndices> SimplifyMesh(const math::PackedVector3* positions, uint32_t vertexCount,
+                                                const uint32_t* indices, size_t indexCount,
+                                                const std::vector<uint32_t>& targetTriangles);
+
+    // appends a chain of levels after the full mesh's indices, each with about half the triangles of the one before.
+    // levels that barely shrink are dropped, lods always starts with the full mesh
+    void BuildLodChain(const std::vector<math::PackedVector3>& positions, std::vector<uint32_t>& indices,
+                       std::vector<render::MeshLod>& lods);
+}
+
+#endif //MESHSIMPLIFIER_H
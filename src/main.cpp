@@ -7,8 +7,12 @@
 #include <imgui.h>
 #include <backends/imgui_impl_sdl3.h>
 #include "imgui/imgui_impl_sdlgpu3.h"
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
 #include <string>
-#include <tiny_gltf.h>
+#include <thread>
 #include <haxe/HaxeGlobals.h>
 #include <render/RenderGlobals.h>
 #include <scene/SceneGlobals.h>
@@ -21,17 +25,33 @@
 #include "asset/Material.h"
 #include "asset/Mesh.h"
 #include "asset/Shader.h"
+#include "debug/Console.h"
+#include "debug/LogRing.h"
+#include "debug/Profiler.h"
+#include "debug/ProfilerView.h"
 #include "scene/SceneSystem.h"
 #include "scene/sceneobj/SceneMesh.h"
 #include "fs/FileSystem.h"
+#include "job/WorkerPool.h"
+#include "loader/AssetLoader.h"
+#include "loader/CookedMesh.h"
+#include "loader/GltfImporter.h"
 #include "haxe/HaxeSystem.h"
 #include "Jolt/Physics/Body/BodyCreationSettings.h"
 #include "Jolt/Physics/Collision/Shape/BoxShape.h"
 #include "log/LogSystem.h"
+#include "physics/FixedStepper.h"
+#include "physics/InterpolatedBodies.h"
+#include "physics/PhysicsSimulation.h"
+#include "render/FrameSnapshot.h"
+#include "render/RenderList.h"
 #include "render/RenderPipeline.h"
 #include "render/SimpleRenderPipeline.h"
+#include "render/UploadRing.h"
 #include "time/TimeGlobal.h"
 #include "render/Window.h"
+#include "script/ScriptBatches.h"
+#include "script/TransformBridge.h"
 
 me::math::PackedVector3 vertices[8] =
 {
@@ -70,13 +90,43 @@ struct AppContext {
     JPH::BodyID cubeId;
     me::scene::SceneMesh* physicsCubeObject;
 
-    me::asset::MeshPtr gltfMesh;
-    me::scene::SceneMesh* gltfMeshObject;
+    // physics runs in fixed steps whatever the frame rate, drawn transforms blend the last two.
+    // the bodies live in a world of our own, the scene's one is stepped every frame by SceneSystem::Update
+    std::unique_ptr<me::physics::PhysicsSimulation> physics;
+    me::physics::FixedStepper physicsStepper;
+    me::physics::InterpolatedBodies physicsBodies;
+
+    std::unique_ptr<me::loader::AssetLoader> assetLoader;
+    std::shared_future<std::vector<me::loader::ImportedMesh>> pendingGltf;
+    std::vector<me::loader::ImportedMesh> gltfMeshes;
+    std::vector<me::scene::SceneMesh*> gltfMeshObjects;
 
     me::asset::MaterialPtr material;
     me::asset::ShaderPtr vertexShader;
     me::asset::ShaderPtr fragmentShader;
-    std::unique_ptr<me::render::RenderPipeline> renderPipeline;
+    std::unique_ptr<me::render::SimpleRenderPipeline> renderPipeline;
+    std::vector<me::scene::SceneMesh*> gridObjects;
+
+    // steps through worker counts, BENCHMARK_FRAMES each, and logs the average cpu time per frame
+    struct {
+        bool running;
+        uint32_t workers;
+        uint32_t frame;
+        uint64_t frameNanoseconds;
+        uint64_t prepareNanoseconds;
+    } threadBenchmark;
+
+    // registers many small meshes at once and records the worst frame of staging until every one is resident
+    struct {
+        bool running;
+        uint32_t frames;
+        uint32_t framesOverBudget;
+        uint32_t maxBytesStaged;
+        uint64_t maxStageNanoseconds;
+        uint64_t start;
+        std::vector<me::scene::SceneMesh*> objects;
+        std::vector<me::render::RenderHandle> handles;
+    } uploadBenchmark;
 
     me::haxe::HaxeType* otherTestType;
     me::haxe::HaxeObject* otherTestObject;
@@ -84,75 +134,364 @@ struct AppContext {
 
     me::scene::GameObject* gameObject;
 
+    std::unique_ptr<me::debug::Console> console;
+    std::unique_ptr<me::debug::ProfilerView> profilerView;
+
+    // with the simulation thread running, physics and capture for step N + 1 run while the main thread draws step N.
+    // scripts always run on the main thread, the HashLink VM and its GC only know that one.
+    // snapshots carry each step over, either thread only touches the scene while it holds sceneMutex
+    me::render::FrameQueue frames { 2 };
+    std::thread simulationThread;
+    std::atomic<bool> simulationRunning;
+    std::mutex sceneMutex;
+    // steps whose scripts ran on the main thread, and how many of those the simulation thread finished, under sceneMutex
+    std::condition_variable stepRequested;
+    uint64_t requestedSteps;
+    uint64_t simulatedSteps;
+    // snapshots the main thread drew since the thread started
+    uint64_t drawnSteps;
+    bool threadedSimulation;
+
     bool shouldQuit;
 };
 
+constexpr uint32_t BENCHMARK_FRAMES = 240;
+
 inline me::math::Vector3 Util_Convert(const JPH::Vec3& vec) {
     return { vec.GetX(), vec.GetY(), vec.GetZ() };
 }
 
-me::asset::ShaderPtr LoadShader(const std::string& path, me::asset::ShaderType type) {
-    vfspp::IFilePtr file = me::fs::OpenFile(path);
-    if (file && file->IsOpened()) {
-        spdlog::info("Opened shader: " + path);
-        size_t size = file->Size();
-        unsigned char* buffer = new unsigned char[size + 1];
-        memset(buffer, 0, size + 1);
-        file->Read(buffer, size);
-        file->Close();
-
-        me::asset::ShaderPtr shader = std::make_shared<me::asset::Shader>(false, type, reinterpret_cast<char*>(buffer), size);
-        return shader;
-    }
-    spdlog::info("Failed to load shader: " + path);
-    return nullptr;
+// the scene can't tell the render list about objects coming and going, so every drawn object goes in through here
+me::render::RenderHandle AddSceneMesh(AppContext* ctx, me::scene::SceneMesh* object) {
+    ctx->scene->GetSceneWorld().AddObject(object);
+    return ctx->renderPipeline->GetRenderList().Add(object);
+}
+
+void SpawnCubeGrid(AppContext* ctx, int size) {
+    for (int x = 0; x < size; x++) {
+        for (int z = 0; z < size; z++) {
+            auto* object = new me::scene::SceneMesh(fmt::format("grid cube {}", ctx->gridObjects.size()));
+            object->GetTransform().SetPosition({ (x - size / 2) * 3.f, -5.f, (z - size / 2) * 3.f });
+            object->mesh = ctx->cubeMesh;
+            object->material = ctx->material;
+            AddSceneMesh(ctx, object);
+            ctx->gridObjects.push_back(object);
+        }
+    }
+}
+
+void SpawnGltf(AppContext* ctx) {
+    ctx->gltfMeshes = ctx->pendingGltf.get();
+    ctx->pendingGltf = {};
+    for (auto& imported : ctx->gltfMeshes) {
+        auto* object = new me::scene::SceneMesh(imported.name);
+        object->GetTransform().SetPosition({ 5.f, 0.f, 0.f });
+        object->mesh = imported.mesh;
+        object->material = ctx->material;
+        AddSceneMesh(ctx, object);
+        ctx->gltfMeshObjects.push_back(object);
+    }
+}
+
+// reads every position so lazily mapped data is actually paged in
+float TouchMeshes(const std::vector<me::loader::ImportedMesh>& meshes) {
+    float sum = 0.0f;
+    for (auto& imported : meshes) {
+        for (uint32_t i = 0; i < imported.geometry->vertexCount; i++) {
+            float position[3];
+            imported.geometry->GetPosition(i, position);
+            sum += position[0] + position[1] + position[2];
+        }
+    }
+    return sum;
+}
+
+// decodes a glTF the given number of times through the glTF parser and through the cooked cache and logs both
+void BenchmarkMeshLoading(const std::string& path, int copies) {
+    // makes sure the cooked file exists
+    me::loader::DecodeGltfCached(path);
+
+    float sink = 0.0f;
+    uint64_t start = SDL_GetTicksNS();
+    for (int i = 0; i < copies; i++) sink += TouchMeshes(me::loader::DecodeGltf(path));
+    uint64_t parseNanoseconds = SDL_GetTicksNS() - start;
+
+    start = SDL_GetTicksNS();
+    for (int i = 0; i < copies; i++) sink += TouchMeshes(me::loader::DecodeGltfCached(path));
+    uint64_t cookedNanoseconds = SDL_GetTicksNS() - start;
+
+    spdlog::info("{} x {}: glTF parse {:.3} ms, cooked {:.3} ms ({:.2}x) [{}]", copies, path, parseNanoseconds / 1e6,
+                 cookedNanoseconds / 1e6, static_cast<double>(parseNanoseconds) / std::max<uint64_t>(cookedNanoseconds, 1), sink);
+}
+
+// builds count cube objects outside the scene and times gathering meshes and model matrices for them,
+// the way Render used to by copying the object list and casting every object, and through a RenderList
+void BenchmarkRenderList(AppContext* ctx, uint32_t count) {
+    constexpr uint32_t frames = 60;
+    std::vector<me::scene::SceneObject*> objects;
+    objects.reserve(count);
+    me::render::RenderList list;
+    list.SetFallbackMaterial(ctx->material);
+    for (uint32_t i = 0; i < count; i++) {
+        auto* object = new me::scene::SceneMesh("benchmark cube");
+        object->GetTransform().SetPosition({ static_cast<float>(i % 100) * 3.f, 0.f, static_cast<float>(i / 100) * 3.f });
+        object->mesh = ctx->cubeMesh;
+        objects.push_back(object);
+        list.Add(object);
+    }
+
+    size_t sink = 0;
+    uint64_t start = SDL_GetTicksNS();
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        std::vector<me::scene::SceneObject*> copied = objects;
+        std::vector<me::asset::Mesh*> meshes;
+        std::vector<me::math::PackedMatrix4x4> models;
+        for (auto* object : copied) {
+            auto* sceneMesh = dynamic_cast<me::scene::SceneMesh*>(object);
+            if (sceneMesh == nullptr || sceneMesh->mesh == nullptr) continue;
+            meshes.push_back(sceneMesh->mesh.get());
+            models.emplace_back();
+            sceneMesh->GetTransform().Raw().ToTRS(true).StoreFloat4x4(models.back());
+        }
+        sink += meshes.size() + models.size();
+    }
+    uint64_t scanNanoseconds = SDL_GetTicksNS() - start;
+
+    start = SDL_GetTicksNS();
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        list.Update();
+        sink += list.GetMeshes().size() + list.GetChanged().size();
+    }
+    uint64_t listNanoseconds = SDL_GetTicksNS() - start;
+
+    spdlog::info("{} objects: {:.3} ms scan and cast, {:.3} ms render list ({:.2}x) [{}]", count, scanNanoseconds / 1e6 / frames,
+                 listNanoseconds / 1e6 / frames, static_cast<double>(scanNanoseconds) / std::max<uint64_t>(listNanoseconds, 1), sink);
+
+    for (auto* object : objects) delete object;
 }
 
-template <typename T>
-std::vector<T> ReadAccessor(tinygltf::Model& model, int id) {
-    tinygltf::Accessor accessor = model.accessors[id];
+// binds count awake bodies to throwaway transforms and times reading them all back BENCHMARK_FRAMES times,
+// body by body through the locking interface, then in bulk on one worker and on every worker
+void BenchmarkBodySync(AppContext* ctx, uint32_t count) {
+    auto& physicsSystem = ctx->physics->GetSystem();
+    auto& bodyInterface = ctx->physics->GetInterface();
+
+    JPH::ShapeRefC shape = new JPH::BoxShape(JPH::Vec3(0.5f, 0.5f, 0.5f));
+    int side = static_cast<int>(std::ceil(std::cbrt(static_cast<double>(count))));
+    std::vector<JPH::BodyID> ids;
+    ids.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        int x = static_cast<int>(i) % side, z = static_cast<int>(i) / side % side, y = static_cast<int>(i) / (side * side);
+        JPH::BodyCreationSettings settings(shape, JPH::RVec3((x - side / 2) * 2.0f, 20.0f + y * 2.0f, (z - side / 2) * 2.0f),
+                                           JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, me::physics::SIMULATION_LAYER_MOVING);
+        JPH::BodyID id = bodyInterface.CreateAndAddBody(settings, JPH::EActivation::Activate);
+        if (id.IsInvalid()) {
+            spdlog::error("Body sync benchmark ran out of bodies after {}", i);
+            break;
+        }
+        ids.push_back(id);
+    }
 
-    std::vector<T> vector(accessor.count);
+    std::vector<me::math::Transform> transforms(ids.size());
+    me::physics::InterpolatedBodies bodies;
+    for (size_t i = 0; i < ids.size(); i++) {
+        bodies.Bind(ids[i], &transforms[i], bodyInterface);
+    }
+
+    uint64_t start = SDL_GetTicksNS();
+    for (uint32_t frame = 0; frame < BENCHMARK_FRAMES; frame++) {
+        for (size_t i = 0; i < ids.size(); i++) {
+            transforms[i].SetPosition(Util_Convert(bodyInterface.GetPosition(ids[i])));
+        }
+    }
+    uint64_t lockedNanoseconds = SDL_GetTicksNS() - start;
 
-    tinygltf::BufferView view = model.bufferViews[accessor.bufferView];
-    tinygltf::Buffer buffer = model.buffers[view.buffer];
+    start = SDL_GetTicksNS();
+    for (uint32_t frame = 0; frame < BENCHMARK_FRAMES; frame++) {
+        bodies.Capture(physicsSystem);
+        bodies.Apply(1.0f);
+    }
+    uint64_t bulkNanoseconds = SDL_GetTicksNS() - start;
 
-    const size_t stride = view.byteStride + sizeof(T);
-    unsigned char* dataPointer = buffer.data.data() + view.byteOffset;
-    for (size_t i = 0; i < accessor.count; i++) {
-        vector[i] = *reinterpret_cast<T*>(dataPointer);
-        dataPointer += stride;
+    start = SDL_GetTicksNS();
+    for (uint32_t frame = 0; frame < BENCHMARK_FRAMES; frame++) {
+        bodies.Capture(physicsSystem, me::job::mainWorkers);
+        bodies.Apply(1.0f, me::job::mainWorkers);
     }
+    uint64_t parallelNanoseconds = SDL_GetTicksNS() - start;
 
-    return std::move(vector);
+    spdlog::info("{} active bodies: {:.3} ms locked per body, {:.3} ms bulk, {:.3} ms bulk on {} workers",
+                 physicsSystem.GetNumActiveBodies(JPH::EBodyType::RigidBody), lockedNanoseconds / 1e6 / BENCHMARK_FRAMES,
+                 bulkNanoseconds / 1e6 / BENCHMARK_FRAMES, parallelNanoseconds / 1e6 / BENCHMARK_FRAMES,
+                 me::job::mainWorkers->GetWorkerCount());
+
+    bodyInterface.RemoveBodies(ids.data(), static_cast<int>(ids.size()));
+    bodyInterface.DestroyBodies(ids.data(), static_cast<int>(ids.size()));
 }
 
-me::asset::MeshPtr LoadMesh(const std::string& path) {
-    vfspp::IFilePtr file = me::fs::OpenFile(path);
-    if (file && file->IsOpened()) {
-        size_t fileSize = file->Size();
-        unsigned char buffer[fileSize];
-        file->Read(buffer, fileSize);
-        file->Close();
-
-        tinygltf::Model gltfModel;
-        tinygltf::TinyGLTF loader;
-        std::string err;
-        std::string warn;
-
-        if (loader.LoadBinaryFromMemory(&gltfModel, &err, &warn, buffer, fileSize)) {
-            // assume mesh zero
-            int posAccessorID = gltfModel.meshes[0].primitives[0].attributes["POSITION"];
-            std::vector<me::math::PackedVector3> vertexBuffer = ReadAccessor<me::math::PackedVector3>(gltfModel, posAccessorID);
-
-            // assume there are indices
-            int indexAccessorID = gltfModel.meshes[0].primitives[0].indices;
-            std::vector<uint16_t> indexBuffer = ReadAccessor<uint16_t>(gltfModel, indexAccessorID);
-
-            return std::make_shared<me::asset::Mesh>(vertexBuffer, indexBuffer);
+// the half of a step that runs scripts, always on the main thread. the caller holds sceneMutex
+void UpdateScripts(AppContext* ctx) {
+    ME_PROFILE_SCOPE("Update Scripts");
+    {
+        ME_PROFILE_SCOPE("SceneSystem::Update");
+        me::scene::mainSystem->Update();
+    }
+
+    // batched script updates write into the bridge's arrays, which go back to the transforms in one pass
+    me::script::mainTransforms.Gather();
+    me::script::mainBatches.Dispatch();
+    me::script::mainTransforms.Apply();
+    me::time::Update();
+
+    ME_PROFILE_SCOPE("SceneSystem::PreRender");
+    me::scene::mainSystem->PreRender();
+}
+
+// the half of a step that never calls into scripts, on the simulation thread when it runs. the caller holds sceneMutex
+void StepSimulation(AppContext* ctx, me::render::FrameSnapshot& snapshot) {
+    ME_PROFILE_SCOPE("Step Simulation");
+    auto& physics = *ctx->physics;
+    ctx->physicsStepper.Advance(me::time::mainGame.GetDelta(), [ctx, &physics](float step) {
+        ME_PROFILE_SCOPE("Physics Step");
+        physics.Step(step);
+        ctx->physicsBodies.Capture(physics.GetSystem(), me::job::mainWorkers);
+    });
+    ctx->physicsBodies.Apply(ctx->physicsStepper.GetAlpha(), me::job::mainWorkers);
+
+    ctx->renderPipeline->Capture(&ctx->scene->GetSceneWorld(), snapshot);
+}
+
+// finishes each step the main thread ran scripts for, the frame queue's depth bounds how far it runs ahead of drawing
+void SimulationMain(AppContext* ctx) {
+    me::debug::mainProfiler.SetThreadName("Simulation");
+    while (ctx->simulationRunning) {
+        {
+            std::unique_lock lock(ctx->sceneMutex);
+            ctx->stepRequested.wait(lock, [ctx] { return !ctx->simulationRunning || ctx->simulatedSteps < ctx->requestedSteps; });
+            if (!ctx->simulationRunning) break;
+        }
+
+        auto snapshot = ctx->frames.BeginWrite();
+        if (!snapshot) break;
+        {
+            std::lock_guard lock(ctx->sceneMutex);
+            StepSimulation(ctx, *snapshot);
+            ctx->simulatedSteps++;
         }
+        ctx->frames.Publish(std::move(snapshot));
+    }
+}
+
+// neither may be called while holding sceneMutex
+void StartSimulationThread(AppContext* ctx) {
+    if (ctx->simulationThread.joinable()) return;
+    ctx->requestedSteps = 0;
+    ctx->simulatedSteps = 0;
+    ctx->drawnSteps = 0;
+    ctx->simulationRunning = true;
+    ctx->simulationThread = std::thread(SimulationMain, ctx);
+}
+
+void StopSimulationThread(AppContext* ctx) {
+    if (!ctx->simulationThread.joinable()) return;
+    {
+        std::lock_guard lock(ctx->sceneMutex);
+        ctx->simulationRunning = false;
+    }
+    ctx->stepRequested.notify_all();
+    ctx->frames.Close();
+    ctx->simulationThread.join();
+    // snapshots it already published stay queued and are still drawn
+    ctx->frames.Reopen();
+}
+
+constexpr uint32_t UPLOAD_BENCHMARK_MESHES = 3000;
+
+// the objects only go into the render list, not the scene, so they can be taken out again once they're resident.
+// the caller holds sceneMutex
+void StartUploadBenchmark(AppContext* ctx) {
+    auto& benchmark = ctx->uploadBenchmark;
+    if (benchmark.running) return;
+    benchmark.running = true;
+    benchmark.frames = 0;
+    benchmark.framesOverBudget = 0;
+    benchmark.maxBytesStaged = 0;
+    benchmark.maxStageNanoseconds = 0;
+    benchmark.start = SDL_GetTicksNS();
+
+    auto& list = ctx->renderPipeline->GetRenderList();
+    for (uint32_t i = 0; i < UPLOAD_BENCHMARK_MESHES; i++) {
+        // a mesh of its own each, so every one is a separate upload
+        auto* object = new me::scene::SceneMesh("upload benchmark cube");
+        object->GetTransform().SetPosition({ (i % 60) * 0.5f - 15.f, 5.f + (i / 60) * 0.5f, 20.f });
+        object->mesh = std::make_shared<me::asset::Mesh>(vertices, 8, indices, 36);
+        object->material = ctx->material;
+        benchmark.objects.push_back(object);
+        benchmark.handles.push_back(list.Add(object));
+    }
+}
+
+// once per frame after drawing, the caller doesn't hold sceneMutex
+void UpdateUploadBenchmark(AppContext* ctx) {
+    auto& benchmark = ctx->uploadBenchmark;
+    if (!benchmark.running) return;
+
+    auto& uploadQueue = ctx->renderPipeline->GetUploadQueue();
+    auto& stats = uploadQueue.GetStats();
+    benchmark.frames++;
+    if (stats.bytesStaged > uploadQueue.GetBudget()) benchmark.framesOverBudget++;
+    benchmark.maxBytesStaged = std::max(benchmark.maxBytesStaged, stats.bytesStaged);
+    benchmark.maxStageNanoseconds = std::max(benchmark.maxStageNanoseconds, stats.stageNanoseconds);
+
+    uint32_t resident = 0;
+    for (auto* object : benchmark.objects) {
+        auto state = uploadQueue.GetState(object->mesh.get());
+        if (state == me::render::MeshUploadState::Pending || state == me::render::MeshUploadState::InFlight) return;
+        if (state == me::render::MeshUploadState::Resident) resident++;
+    }
+    // meshes only reach the queue once their snapshot is drawn, and one the pool had no room for never does
+    if (resident < benchmark.objects.size() && benchmark.frames < 8) return;
+
+    spdlog::info("{} / {} meshes resident after {} frames ({:.3} ms): at most {} KiB and {:.3} ms staged per frame, "
+                 "budget {} KiB, {} frames over it", resident, benchmark.objects.size(), benchmark.frames,
+                 (SDL_GetTicksNS() - benchmark.start) / 1e6, benchmark.maxBytesStaged / 1024, benchmark.maxStageNanoseconds / 1e6,
+                 uploadQueue.GetBudget() / 1024, benchmark.framesOverBudget);
+
+    // snapshots don't point at the objects, the list keeps the meshes alive until the last snapshot drawing them is done
+    std::lock_guard lock(ctx->sceneMutex);
+    auto& list = ctx->renderPipeline->GetRenderList();
+    for (me::render::RenderHandle handle : benchmark.handles) list.Remove(handle);
+    for (auto* object : benchmark.objects) delete object;
+    benchmark.objects.clear();
+    benchmark.handles.clear();
+    benchmark.running = false;
+}
+
+void StartThreadBenchmark(AppContext* ctx) {
+    ctx->threadBenchmark = { true, 1, 0, 0, 0 };
+    me::job::mainWorkers->SetWorkerCount(1);
+}
+
+void UpdateThreadBenchmark(AppContext* ctx, uint64_t frameNanoseconds) {
+    auto& benchmark = ctx->threadBenchmark;
+    if (!benchmark.running) return;
+
+    benchmark.frameNanoseconds += frameNanoseconds;
+    benchmark.prepareNanoseconds += ctx->renderPipeline->GetStats().prepareNanoseconds;
+    if (++benchmark.frame < BENCHMARK_FRAMES) return;
+
+    spdlog::info("{} workers: {:.3} ms frame, {:.3} ms render prepare ({} objects)", benchmark.workers,
+                 benchmark.frameNanoseconds / 1e6 / BENCHMARK_FRAMES, benchmark.prepareNanoseconds / 1e6 / BENCHMARK_FRAMES,
+                 ctx->renderPipeline->GetCullStats().tested);
+
+    uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (benchmark.workers >= hardwareThreads) {
+        benchmark.running = false;
+        me::job::mainWorkers->SetWorkerCount(0);
+        return;
     }
-    return nullptr;
+    benchmark = { true, std::min(benchmark.workers * 2, hardwareThreads), 0, 0, 0 };
+    me::job::mainWorkers->SetWorkerCount(benchmark.workers);
 }
 
 SDL_AppResult SDL_AppInit(void** appstate, int argc, char* argv[]) {
@@ -160,16 +499,41 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char* argv[]) {
         spdlog::critical("Failed to initialize MANIFOLDEngine");
         return SDL_APP_FAILURE;
     }
+    // loggers keep a sink pointing at the ring, so it's never freed
+    me::debug::mainLogRing = new me::debug::LogRing(8192);
+    me::debug::AttachLogRing(*me::debug::mainLogRing);
+    me::debug::mainProfiler.SetThreadName("Main");
     me::render::CreateMainWindow("MECore Test", { 1280, 720 });
+    me::render::mainUploadRing = new me::render::UploadRing(me::render::mainDevice, 64 * 1024 * 1024);
+    me::job::mainWorkers = new me::job::WorkerPool();
     // me::haxe::CreateMainSystem("/code.hl");
 
     auto ctx = new AppContext();
     ctx->shouldQuit = false;
-
-    // load shaders
-    ctx->vertexShader = LoadShader("/shaders/vertex.hlsl", me::asset::ShaderType::Vertex);
-    ctx->fragmentShader = LoadShader("/shaders/fragment.hlsl", me::asset::ShaderType::Fragment);
-    ctx->material = std::make_shared<me::asset::Material>(ctx->vertexShader, ctx->fragmentShader);
+    ctx->console = std::make_unique<me::debug::Console>(*me::debug::mainLogRing);
+    ctx->profilerView = std::make_unique<me::debug::ProfilerView>(me::debug::mainProfiler);
+    ctx->simulationRunning = false;
+    ctx->requestedSteps = 0;
+    ctx->simulatedSteps = 0;
+    ctx->drawnSteps = 0;
+    ctx->threadedSimulation = false;
+    ctx->threadBenchmark = {};
+    ctx->uploadBenchmark = {};
+
+    // everything loads at once, only the material is waited on, the glTF shows up whenever it's ready
+    uint64_t loadStart = SDL_GetTicksNS();
+    ctx->assetLoader = std::make_unique<me::loader::AssetLoader>();
+    ctx->assetLoader->SetHotReload(true);
+    auto vertexShader = ctx->assetLoader->LoadShader("/shaders/vertex.hlsl", me::asset::ShaderType::Vertex);
+    auto fragmentShader = ctx->assetLoader->LoadShader("/shaders/fragment.hlsl", me::asset::ShaderType::Fragment);
+    auto material = ctx->assetLoader->LoadMaterial(vertexShader, fragmentShader);
+    // optimized and simplified once when it's cooked, cache hits don't pay for it again
+    ctx->pendingGltf = ctx->assetLoader->LoadGltf("/alitrophy.glb", { .optimize = true, .generateLods = true, .quantize = true });
+
+    ctx->material = ctx->assetLoader->Wait(material);
+    ctx->vertexShader = vertexShader.get();
+    ctx->fragmentShader = fragmentShader.get();
+    spdlog::info("Material ready after {:.3} ms", (SDL_GetTicksNS() - loadStart) / 1e6);
     ctx->renderPipeline = std::make_unique<me::render::SimpleRenderPipeline>(ctx->material);
 
     ctx->scene = std::make_shared<me::scene::Scene>();
@@ -182,19 +546,13 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char* argv[]) {
     ctx->cubeMeshObject = new me::scene::SceneMesh("cube");
     ctx->cubeMeshObject->mesh = ctx->cubeMesh;
     ctx->cubeMeshObject->material = ctx->material;
-    ctx->scene->GetSceneWorld().AddObject(ctx->cubeMeshObject);
+    AddSceneMesh(ctx, ctx->cubeMeshObject);
 
     ctx->physicsCubeObject = new me::scene::SceneMesh("physics cube");
     ctx->physicsCubeObject->mesh = ctx->cubeMesh;
     ctx->physicsCubeObject->material = ctx->material;
-    ctx->scene->GetSceneWorld().AddObject(ctx->physicsCubeObject);
+    AddSceneMesh(ctx, ctx->physicsCubeObject);
 
-    ctx->gltfMesh = LoadMesh("/alitrophy.glb");
-    ctx->gltfMeshObject = new me::scene::SceneMesh("gltf");
-    ctx->gltfMeshObject->GetTransform().SetPosition({ 5.f, 0.f, 0.f });
-    ctx->gltfMeshObject->mesh = ctx->gltfMesh;
-    ctx->gltfMeshObject->material = ctx->material;
-    ctx->scene->GetSceneWorld().AddObject(ctx->gltfMeshObject);
 
     ctx->gameObject = new me::scene::GameObject("test object");
     auto* compType = me::haxe::mainSystem->GetType(u"TestComponent");
@@ -205,21 +563,23 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char* argv[]) {
     me::scene::mainSystem->AddScene(ctx->scene);
 
     // add physics cube
-    auto& bodyInterface = ctx->scene->GetPhysicsWorld().GetInterface();
+    ctx->physics = std::make_unique<me::physics::PhysicsSimulation>();
+    auto& bodyInterface = ctx->physics->GetInterface();
 
     ctx->floorShapeSettings.SetEmbedded();
     JPH::ShapeSettings::ShapeResult floorShapeResult = ctx->floorShapeSettings.Create();
     JPH::ShapeRefC floorShape = floorShapeResult.Get();
 
-    JPH::BodyCreationSettings floorCreateSettings(floorShape, JPH::RVec3(0.0f, -1.0f, 0.0f), JPH::Quat::sIdentity(), JPH::EMotionType::Static, static_cast<JPH::ObjectLayer>(me::physics::PhysicsLayer::Static));
+    JPH::BodyCreationSettings floorCreateSettings(floorShape, JPH::RVec3(0.0f, -1.0f, 0.0f), JPH::Quat::sIdentity(), JPH::EMotionType::Static, me::physics::SIMULATION_LAYER_STATIC);
 
     ctx->floor = bodyInterface.CreateBody(floorCreateSettings);
     bodyInterface.AddBody(ctx->floor->GetID(), JPH::EActivation::DontActivate);
 
-    JPH::BodyCreationSettings cubeSettings(new JPH::BoxShape(JPH::RVec3(1, 1, 1)), JPH::RVec3(0, 10, 0), JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, static_cast<JPH::ObjectLayer>(me::physics::PhysicsLayer::Dynamic));
+    JPH::BodyCreationSettings cubeSettings(new JPH::BoxShape(JPH::RVec3(1, 1, 1)), JPH::RVec3(0, 10, 0), JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, me::physics::SIMULATION_LAYER_MOVING);
     ctx->cubeId = bodyInterface.CreateAndAddBody(cubeSettings, JPH::EActivation::Activate);
 
     bodyInterface.SetLinearVelocity(ctx->cubeId, JPH::Vec3(0, 5, 0));
+    ctx->physicsBodies.Bind(ctx->cubeId, &ctx->physicsCubeObject->GetTransform(), bodyInterface);
 
     // INIT IMGUI
     IMGUI_CHECKVERSION();
@@ -250,27 +610,164 @@ SDL_AppResult SDL_AppEvent(void* appstate, SDL_Event* event) {
 
 SDL_AppResult SDL_AppIterate(void* appstate) {
     auto* ctx = static_cast<AppContext*>(appstate);
+    uint64_t frameStart = SDL_GetTicksNS();
+    me::debug::mainProfiler.EndFrame();
+    ME_PROFILE_SCOPE("SDL_AppIterate");
 
-    me::scene::mainSystem->Update();
-    me::time::Update();
-
-    auto& bodyInterface = ctx->scene->GetPhysicsWorld().GetInterface();
+    // the simulation thread, if it runs, is between steps while this is held
+    std::unique_lock sceneLock(ctx->sceneMutex);
 
-    me::math::Vector3 pos = Util_Convert(bodyInterface.GetPosition(ctx->cubeId));
-    ctx->physicsCubeObject->GetTransform().SetPosition(pos);
+    ctx->assetLoader->Update();
+    if (ctx->pendingGltf.valid() && ctx->pendingGltf.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        SpawnGltf(ctx);
+    }
 
     ImGui_ImplSDL3_NewFrame();
     ImGui_ImplSDLGPU3_NewFrame();
     ImGui::NewFrame();
-    ImGui::Begin("Console");
-    ImGui::Text(me::log::stream.str().c_str());
-    ImGui::End();
+    ctx->console->Draw("Console");
+    ctx->profilerView->Draw("Profiler");
 
     ImGui::Begin("Basic Debug Panel");
 
     ImGui::Text(fmt::format("Game Time: {:0.2}", me::time::mainGame.GetElapsed()).c_str());
     ImGui::Text(fmt::format("Game Time Delta: {:.4}", me::time::mainGame.GetDelta()).c_str());
 
+    ImGui::Text(fmt::format("Assets Loading: {}", ctx->assetLoader->GetPending()).c_str());
+    ImGui::Text(fmt::format("Pipelines Building: {}", ctx->renderPipeline->GetPipelines().GetBuilding()).c_str());
+    bool hotReload = ctx->assetLoader->GetHotReload();
+    if (ImGui::Checkbox("Hot Reload Shaders", &hotReload)) ctx->assetLoader->SetHotReload(hotReload);
+    if (ImGui::Button("Benchmark Mesh Loading")) {
+        BenchmarkMeshLoading("/alitrophy.glb", 32);
+    }
+
+    if (ImGui::CollapsingHeader("Scripts")) {
+        auto& batchStats = me::script::mainBatches.GetStats();
+        auto& bridgeStats = me::script::mainTransforms.GetStats();
+        ImGui::Text(fmt::format("Batches: {} ({} failed), {:.3} ms", batchStats.batches, batchStats.failed,
+                                batchStats.dispatchNanoseconds / 1e6).c_str());
+        ImGui::Text(fmt::format("Bridged Transforms: {} ({:.3} ms gather, {:.3} ms apply)", bridgeStats.bound,
+                                bridgeStats.gatherNanoseconds / 1e6, bridgeStats.applyNanoseconds / 1e6).c_str());
+        for (uint32_t i = 0; i < me::script::mainBatches.GetCommandCount(); i++) {
+            if (ImGui::Button(me::script::mainBatches.GetCommandName(i).c_str())) {
+                me::script::mainBatches.RunCommand(i);
+            }
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Physics")) {
+        auto& stepper = ctx->physicsStepper;
+        auto& stepStats = stepper.GetStats();
+        int stepRate = static_cast<int>(std::round(1.0 / stepper.GetStepSeconds()));
+        if (ImGui::SliderInt("Step Rate (Hz)", &stepRate, 10, 240)) {
+            stepper.SetStepSeconds(1.0 / stepRate);
+        }
+        int maxSteps = static_cast<int>(stepper.GetMaxSteps());
+        if (ImGui::SliderInt("Max Steps per Frame", &maxSteps, 1, 16)) {
+            stepper.SetMaxSteps(static_cast<uint32_t>(maxSteps));
+        }
+        ImGui::Text(fmt::format("Steps: {} ({:.3} ms), Alpha: {:.2}", stepStats.steps, stepStats.stepNanoseconds / 1e6, stepper.GetAlpha()).c_str());
+        ImGui::Text(fmt::format("Total Steps: {}, Dropped: {:.3} s", stepStats.totalSteps, stepStats.droppedSeconds).c_str());
+        auto& syncStats = ctx->physicsBodies.GetStats();
+        ImGui::Text(fmt::format("Bound Bodies: {} ({} of {} active captured)", ctx->physicsBodies.Size(), syncStats.captured, syncStats.active).c_str());
+        ImGui::Text(fmt::format("Sync: {:.3} ms capture, {:.3} ms apply ({} transforms)", syncStats.captureNanoseconds / 1e6,
+                                syncStats.applyNanoseconds / 1e6, syncStats.applied).c_str());
+        if (ImGui::Button("Benchmark Body Sync")) {
+            BenchmarkBodySync(ctx, 10000);
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Renderer")) {
+        auto& cullStats = ctx->renderPipeline->GetCullStats();
+        auto& renderStats = ctx->renderPipeline->GetStats();
+        ImGui::Text(fmt::format("Visible: {} / {} (culled {})", cullStats.visible, cullStats.tested, cullStats.culled).c_str());
+        ImGui::Text(fmt::format("Draw Calls: {} ({} indirect commands, {} instances)", renderStats.drawCalls,
+                                renderStats.indirectCommands, renderStats.instances).c_str());
+        ImGui::Text(fmt::format("Capture: {:.3} ms, Prepare: {:.3} ms, Draw Recording: {:.3} ms", renderStats.captureNanoseconds / 1e6,
+                                renderStats.prepareNanoseconds / 1e6, renderStats.recordNanoseconds / 1e6).c_str());
+
+        ImGui::Checkbox("Threaded Simulation", &ctx->threadedSimulation);
+        auto frameStats = ctx->frames.GetStats();
+        int depth = static_cast<int>(frameStats.depth);
+        if (ImGui::SliderInt("Frame Queue Depth", &depth, 1, 4)) {
+            ctx->frames.SetDepth(static_cast<uint32_t>(depth));
+        }
+        ImGui::Text(fmt::format("Latency: {:.3} ms, {} queued", frameStats.latencyNanoseconds / 1e6, frameStats.queued).c_str());
+        ImGui::Text(fmt::format("Simulated: {:.1} / s (waited {:.3} ms), Drawn: {:.1} / s (waited {:.3} ms)",
+                                frameStats.producedPerSecond, frameStats.produceWaitNanoseconds / 1e6,
+                                frameStats.consumedPerSecond, frameStats.consumeWaitNanoseconds / 1e6).c_str());
+
+        int workers = static_cast<int>(me::job::mainWorkers->GetWorkerCount());
+        int hardwareThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        ImGui::BeginDisabled(ctx->threadBenchmark.running);
+        if (ImGui::SliderInt("Workers", &workers, 1, hardwareThreads)) {
+            me::job::mainWorkers->SetWorkerCount(static_cast<uint32_t>(workers));
+        }
+        if (ImGui::Button("Spawn Cube Grid")) {
+            SpawnCubeGrid(ctx, 64);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Benchmark Workers")) {
+            StartThreadBenchmark(ctx);
+        }
+        if (ImGui::Button("Benchmark Render List")) {
+            for (uint32_t count : { 1000u, 10000u, 100000u }) BenchmarkRenderList(ctx, count);
+        }
+        ImGui::EndDisabled();
+        if (ctx->threadBenchmark.running) {
+            ImGui::Text(fmt::format("Benchmarking {} workers, frame {} / {}", ctx->threadBenchmark.workers,
+                                    ctx->threadBenchmark.frame, BENCHMARK_FRAMES).c_str());
+        }
+
+        bool indirect = ctx->renderPipeline->GetRenderPath() == me::render::RenderPath::Indirect;
+        ImGui::BeginDisabled(!me::render::SimpleRenderPipeline::SupportsIndirect());
+        if (ImGui::Checkbox("Indirect Draws", &indirect)) {
+            ctx->renderPipeline->SetRenderPath(indirect ? me::render::RenderPath::Indirect : me::render::RenderPath::Direct);
+        }
+        ImGui::EndDisabled();
+        ImGui::Text(fmt::format("Binds: {} issued, {} skipped", renderStats.bindsIssued, renderStats.bindsSkipped).c_str());
+
+        auto& lodSelector = ctx->renderPipeline->GetLodSelector();
+        ImGui::Text(fmt::format("Triangles: {} ({} without LODs)", renderStats.triangles, renderStats.fullTriangles).c_str());
+        float errorPixels = lodSelector.GetErrorPixels();
+        if (ImGui::SliderFloat("LOD Error (px)", &errorPixels, 0.1f, 16.0f)) {
+            lodSelector.SetErrorPixels(errorPixels);
+        }
+        float hysteresis = lodSelector.GetHysteresis();
+        if (ImGui::SliderFloat("LOD Hysteresis", &hysteresis, 0.0f, 1.0f)) {
+            lodSelector.SetHysteresis(hysteresis);
+        }
+        int forcedLod = lodSelector.GetForcedLod();
+        if (ImGui::SliderInt("Force LOD", &forcedLod, -1, static_cast<int>(me::render::MAX_MESH_LODS) - 1)) {
+            lodSelector.SetForcedLod(forcedLod);
+        }
+        ImGui::Text(fmt::format("Upload Ring: {} / {} KiB, {} frames in flight", me::render::mainUploadRing->GetUsed() / 1024,
+                                me::render::mainUploadRing->GetCapacity() / 1024, me::render::mainUploadRing->GetFramesInFlight()).c_str());
+
+        auto& uploadQueue = ctx->renderPipeline->GetUploadQueue();
+        auto& uploadStats = uploadQueue.GetStats();
+        ImGui::Text(fmt::format("Mesh Uploads: {} pending, {} in flight", uploadStats.pending, uploadStats.inFlight).c_str());
+        ImGui::Text(fmt::format("Staged: {} KiB in {} copies ({:.3} ms)", uploadStats.bytesStaged / 1024, uploadStats.copies,
+                                uploadStats.stageNanoseconds / 1e6).c_str());
+        int budgetKiB = static_cast<int>(uploadQueue.GetBudget() / 1024);
+        if (ImGui::SliderInt("Upload Budget (KiB)", &budgetKiB, 64, 32 * 1024)) {
+            uploadQueue.SetBudget(static_cast<uint32_t>(budgetKiB) * 1024);
+        }
+        ImGui::BeginDisabled(ctx->uploadBenchmark.running);
+        if (ImGui::Button("Benchmark Mesh Uploads")) {
+            StartUploadBenchmark(ctx);
+        }
+        ImGui::EndDisabled();
+
+        auto poolStats = ctx->renderPipeline->GetGeometryPool().GetStats();
+        ImGui::Text(fmt::format("Geometry Pool: {} / {} KiB vertices, {} / {} KiB indices", poolStats.vertexBytesUsed / 1024,
+                                poolStats.vertexBytesCapacity / 1024, poolStats.indexBytesUsed / 1024, poolStats.indexBytesCapacity / 1024).c_str());
+        ImGui::Text(fmt::format("Free Blocks: {}, Relocations: {}", poolStats.freeBlocks, poolStats.relocations).c_str());
+        if (ImGui::Button("Defragment")) {
+            ctx->renderPipeline->RequestDefragment();
+        }
+    }
+
     if (ImGui::CollapsingHeader("Active Scene World")) {
         if (ImGui::TreeNode("Camera")) {
             auto& camera = ctx->scene->GetSceneWorld().GetCamera();
@@ -322,11 +819,55 @@ SDL_AppResult SDL_AppIterate(void* appstate) {
         }
     }
     ImGui::End();
+    {
+        ME_PROFILE_SCOPE("ImGui::Render");
+        ImGui::Render();
+    }
 
-    me::scene::mainSystem->PreRender();
+    // without the thread the whole step runs right here, once whatever it left queued is drawn.
+    // with it only the scripts do, and only once the thread caught up with the last step.
+    // the frame the thread is switched on steps nothing, so its first snapshot is the first one queued
+    bool requested = false;
+    if (ctx->simulationThread.joinable()) {
+        if (ctx->simulatedSteps == ctx->requestedSteps) {
+            UpdateScripts(ctx);
+            ctx->requestedSteps++;
+            requested = true;
+        }
+    } else if (!ctx->threadedSimulation && ctx->frames.GetQueued() == 0) {
+        auto snapshot = ctx->frames.BeginWrite();
+        UpdateScripts(ctx);
+        StepSimulation(ctx, *snapshot);
+        ctx->frames.Publish(std::move(snapshot));
+    }
+    // the step just requested is simulated while the one before it is drawn
+    bool drawPrevious = ctx->simulationThread.joinable() && ctx->requestedSteps - ctx->drawnSteps >= (requested ? 2 : 1);
+    sceneLock.unlock();
+    if (requested) ctx->stepRequested.notify_one();
+
+    if (ctx->threadedSimulation) {
+        StartSimulationThread(ctx);
+    } else {
+        StopSimulationThread(ctx);
+    }
 
-    ImGui::Render();
-    ctx->renderPipeline->Render(&ctx->scene->GetSceneWorld());
+    // right after starting or stopping the thread there may be nothing to draw, that frame is skipped
+    std::unique_ptr<me::render::FrameSnapshot> snapshot;
+    if (ctx->simulationThread.joinable()) {
+        if (drawPrevious) {
+            ME_PROFILE_SCOPE("Wait For Frame");
+            snapshot = ctx->frames.BeginRead();
+            if (snapshot) ctx->drawnSteps++;
+        }
+    } else {
+        snapshot = ctx->frames.TryRead();
+    }
+    if (snapshot) {
+        ctx->renderPipeline->Render(*snapshot);
+        ctx->frames.Release(std::move(snapshot));
+    }
+    UpdateThreadBenchmark(ctx, SDL_GetTicksNS() - frameStart);
+    UpdateUploadBenchmark(ctx);
 
     return ctx->shouldQuit ? SDL_APP_SUCCESS : SDL_APP_CONTINUE;
 }
@@ -335,12 +876,20 @@ void SDL_AppQuit(void* appstate, SDL_AppResult result) {
     auto* ctx = static_cast<AppContext*>(appstate);
 
     if (ctx) {
+        StopSimulationThread(ctx);
         delete ctx;
     }
+    // the closures are gc roots, they have to go before the VM does
+    me::script::mainBatches.Clear();
 
     ImGui_ImplSDL3_Shutdown();
     ImGui_ImplSDLGPU3_Shutdown();
     ImGui::DestroyContext();
 
+    delete me::render::mainUploadRing;
+    me::render::mainUploadRing = nullptr;
+    delete me::job::mainWorkers;
+    me::job::mainWorkers = nullptr;
+
     me::Shutdown();
 }
@@ -0,0 +1,54 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "FixedStepper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <SDL3/SDL.h>
+
+namespace me::physics {
+    FixedStepper::FixedStepper(double stepSeconds, uint32_t maxSteps) {
+        SetStepSeconds(stepSeconds);
+        SetMaxSteps(maxSteps);
+    }
+
+    uint32_t FixedStepper::Advance(double deltaSeconds, const std::function<void(float)>& step) {
+        accumulator += std::max(deltaSeconds, 0.0);
+
+        uint64_t start = SDL_GetTicksNS();
+        uint32_t steps = 0;
+        while (accumulator >= stepSeconds && steps < maxSteps) {
+            step(static_cast<float>(stepSeconds));
+            accumulator -= stepSeconds;
+            steps++;
+        }
+
+        // behind by more than the limit allows, keep the fraction so alpha stays smooth
+        if (accumulator >= stepSeconds) {
+            double dropped = accumulator - std::fmod(accumulator, stepSeconds);
+            stats.droppedSeconds += dropped;
+            accumulator -= dropped;
+        }
+
+        alpha = static_cast<float>(accumulator / stepSeconds);
+        stats.steps = steps;
+        stats.stepNanoseconds = SDL_GetTicksNS() - start;
+        stats.totalSteps += steps;
+        return steps;
+    }
+
+    void FixedStepper::Reset() {
+        accumulator = 0.0;
+        alpha = 0.0f;
+    }
+
+    void FixedStepper::SetStepSeconds(double seconds) {
+        stepSeconds = std::max(seconds, 1e-4);
+    }
+
+    void FixedStepper::SetMaxSteps(uint32_t steps) {
+        maxSteps = std::max(steps, 1u);
+    }
+}
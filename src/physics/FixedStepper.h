@@ -0,0 +1,50 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef FIXEDSTEPPER_H
+#define FIXEDSTEPPER_H
+
+#include <cstdint>
+#include <functional>
+
+namespace me::physics {
+    struct FixedStepStats {
+        // steps run by the last Advance and the cpu time they took
+        uint32_t steps;
+        uint64_t stepNanoseconds;
+        uint64_t totalSteps;
+        // simulated time thrown away because frames needed more than the step limit
+        double droppedSeconds;
+    };
+
+    // advances a simulation in fixed steps from variable frame deltas.
+    // time that doesn't fill a step carries over, alpha is how far the frame lands between the last two steps.
+    // at most maxSteps run per Advance, past that the time is dropped so one slow frame can't make every later one slower
+    class FixedStepper {
+        private:
+        double stepSeconds;
+        uint32_t maxSteps;
+        double accumulator = 0.0;
+        float alpha = 0.0f;
+        FixedStepStats stats = {};
+
+        public:
+        FixedStepper(double stepSeconds = 1.0 / 60.0, uint32_t maxSteps = 5);
+
+        // runs step once per whole step accumulated, with the step length. returns how many ran
+        uint32_t Advance(double deltaSeconds, const std::function<void(float)>& step);
+        // 0 is the state of the second to last step, 1 the last
+        float GetAlpha() const { return alpha; }
+        // forgets accumulated time, for jumps like loading a level
+        void Reset();
+
+        void SetStepSeconds(double seconds);
+        double GetStepSeconds() const { return stepSeconds; }
+        void SetMaxSteps(uint32_t steps);
+        uint32_t GetMaxSteps() const { return maxSteps; }
+        const FixedStepStats& GetStats() const { return stats; }
+    };
+}
+
+#endif //FIXEDSTEPPER_H
@@ -0,0 +1,158 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "InterpolatedBodies.h"
+
+#include <SDL3/SDL.h>
+
+#include "../debug/Profiler.h"
+
+namespace me::physics {
+    // bodies per chunk when capture and apply run on workers
+    constexpr uint32_t SYNC_GRAIN = 1024;
+
+    void InterpolatedBodies::Write(uint32_t slot, float alpha) {
+        JPH::RVec3 position = previousPositions[slot] + (positions[slot] - previousPositions[slot]) * alpha;
+        JPH::Quat rotation = previousRotations[slot].SLerp(rotations[slot], alpha);
+
+        auto& raw = transforms[slot]->Raw();
+        float* outPosition = reinterpret_cast<float*>(&raw.position);
+        outPosition[0] = static_cast<float>(position.GetX());
+        outPosition[1] = static_cast<float>(position.GetY());
+        outPosition[2] = static_cast<float>(position.GetZ());
+        // xyzw, the same order Jolt keeps them in
+        float* outRotation = reinterpret_cast<float*>(&raw.rotation);
+        outRotation[0] = rotation.GetX();
+        outRotation[1] = rotation.GetY();
+        outRotation[2] = rotation.GetZ();
+        outRotation[3] = rotation.GetW();
+    }
+
+    void InterpolatedBodies::Bind(JPH::BodyID body, math::Transform* transform, const JPH::BodyInterface& bodyInterface) {
+        Unbind(body);
+
+        uint32_t slot;
+        if (freeSlots.empty()) {
+            slot = static_cast<uint32_t>(bodies.size());
+            bodies.emplace_back();
+            transforms.push_back(nullptr);
+            previousPositions.emplace_back();
+            previousRotations.emplace_back();
+            positions.emplace_back();
+            rotations.emplace_back();
+            capturedSteps.push_back(0);
+        } else {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+
+        bodies[slot] = body;
+        transforms[slot] = transform;
+        bodyInterface.GetPositionAndRotation(body, positions[slot], rotations[slot]);
+        previousPositions[slot] = positions[slot];
+        previousRotations[slot] = rotations[slot];
+        capturedSteps[slot] = step;
+        settling.push_back(slot);
+
+        uint32_t index = body.GetIndex();
+        if (index >= bodyToSlot.size()) bodyToSlot.resize(index + 1, NO_SLOT);
+        bodyToSlot[index] = slot;
+    }
+
+    void InterpolatedBodies::Unbind(JPH::BodyID body) {
+        uint32_t index = body.GetIndex();
+        if (index >= bodyToSlot.size()) return;
+        uint32_t slot = bodyToSlot[index];
+        if (slot == NO_SLOT || !(bodies[slot] == body)) return;
+
+        bodyToSlot[index] = NO_SLOT;
+        transforms[slot] = nullptr;
+        bodies[slot] = JPH::BodyID();
+        freeSlots.push_back(slot);
+        // moving may still name the slot, a free slot is skipped
+    }
+
+    void InterpolatedBodies::Capture(const JPH::PhysicsSystem& system, job::WorkerPool* workers) {
+        ME_PROFILE_SCOPE("Body Capture");
+        uint64_t start = SDL_GetTicksNS();
+        step++;
+
+        // the list is only stable between steps, which is when this runs
+        uint32_t count = system.GetNumActiveBodies(JPH::EBodyType::RigidBody);
+        const JPH::BodyID* active = system.GetActiveBodiesUnsafe(JPH::EBodyType::RigidBody);
+        const JPH::BodyInterface& bodyInterface = system.GetBodyInterfaceNoLock();
+
+        std::swap(moving, previousMoving);
+        moving.resize(count);
+
+        std::atomic<uint32_t> captured = 0;
+        job::RangeTask task = [&](uint32_t begin, uint32_t end, uint32_t) {
+            uint32_t chunkCaptured = 0;
+            for (uint32_t i = begin; i < end; i++) {
+                JPH::BodyID body = active[i];
+                uint32_t index = body.GetIndex();
+                uint32_t slot = index < bodyToSlot.size() ? bodyToSlot[index] : NO_SLOT;
+                if (slot == NO_SLOT || !(bodies[slot] == body)) {
+                    moving[i] = NO_SLOT;
+                    continue;
+                }
+
+                previousPositions[slot] = positions[slot];
+                previousRotations[slot] = rotations[slot];
+                bodyInterface.GetPositionAndRotation(body, positions[slot], rotations[slot]);
+                capturedSteps[slot] = step;
+                moving[i] = slot;
+                chunkCaptured++;
+            }
+            captured += chunkCaptured;
+        };
+        if (workers == nullptr) {
+            task(0, count, 0);
+        } else {
+            workers->ParallelFor(count, SYNC_GRAIN, task);
+        }
+
+        // bodies that went to sleep since the last step stop where they are
+        for (uint32_t slot : previousMoving) {
+            if (slot == NO_SLOT || transforms[slot] == nullptr || capturedSteps[slot] == step) continue;
+            previousPositions[slot] = positions[slot];
+            previousRotations[slot] = rotations[slot];
+            capturedSteps[slot] = step;
+            settling.push_back(slot);
+        }
+
+        stats.active = count;
+        stats.captured = captured;
+        captureNanoseconds += SDL_GetTicksNS() - start;
+    }
+
+    void InterpolatedBodies::Apply(float alpha, job::WorkerPool* workers) {
+        ME_PROFILE_SCOPE("Body Apply");
+        uint64_t start = SDL_GetTicksNS();
+
+        for (uint32_t slot : settling) {
+            if (transforms[slot] != nullptr) Write(slot, 1.0f);
+        }
+        uint32_t applied = static_cast<uint32_t>(settling.size());
+        settling.clear();
+
+        job::RangeTask task = [this, alpha](uint32_t begin, uint32_t end, uint32_t) {
+            for (uint32_t i = begin; i < end; i++) {
+                uint32_t slot = moving[i];
+                if (slot != NO_SLOT && transforms[slot] != nullptr) Write(slot, alpha);
+            }
+        };
+        uint32_t count = static_cast<uint32_t>(moving.size());
+        if (workers == nullptr) {
+            task(0, count, 0);
+        } else {
+            workers->ParallelFor(count, SYNC_GRAIN, task);
+        }
+
+        stats.applied = applied + stats.captured;
+        stats.captureNanoseconds = captureNanoseconds;
+        stats.applyNanoseconds = SDL_GetTicksNS() - start;
+        captureNanoseconds = 0;
+    }
+}
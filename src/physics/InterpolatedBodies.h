@@ -0,0 +1,79 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef INTERPOLATEDBODIES_H
+#define INTERPOLATEDBODIES_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+
+#include "math/Transform.h"
+#include "../job/WorkerPool.h"
+
+namespace me::physics {
+    struct BodySyncStats {
+        // bodies on the active list at the last capture, and how many of them were bound
+        uint32_t active;
+        uint32_t captured;
+        // cpu time for every capture since the last Apply, and for the Apply itself
+        uint64_t captureNanoseconds;
+        uint64_t applyNanoseconds;
+        // transforms written by the last Apply
+        uint32_t applied;
+    };
+
+    // table from physics bodies to the scene transforms that follow them.
+    // after a step only bodies on Jolt's active list are read, through the no-lock interface and in chunks over workers,
+    // so sleeping bodies cost nothing. every step's state is kept with the one before it,
+    // so a frame landing between two steps draws the blend rather than whichever step ran last.
+    // Capture and Apply must not overlap a physics step
+    class InterpolatedBodies {
+        private:
+        static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+        // slots are reused after Unbind, a free slot has no transform
+        std::vector<JPH::BodyID> bodies;
+        std::vector<math::Transform*> transforms;
+        std::vector<JPH::RVec3> previousPositions;
+        std::vector<JPH::Quat> previousRotations;
+        std::vector<JPH::RVec3> positions;
+        std::vector<JPH::Quat> rotations;
+        // capture the slot was last read in
+        std::vector<uint64_t> capturedSteps;
+        std::vector<uint32_t> freeSlots;
+        // slot of every body, indexed by body index
+        std::vector<uint32_t> bodyToSlot;
+
+        // slot of each body on the active list at the last capture, NO_SLOT where it isn't bound
+        std::vector<uint32_t> moving;
+        std::vector<uint32_t> previousMoving;
+        // slots that stopped moving or were just bound, written once at their latest state by the next Apply
+        std::vector<uint32_t> settling;
+        uint64_t step = 0;
+        // captures since the last Apply, moved into stats by it
+        uint64_t captureNanoseconds = 0;
+
+        BodySyncStats stats = {};
+
+        void Write(uint32_t slot, float alpha);
+
+        public:
+        // starts at rest on the body's current state
+        void Bind(JPH::BodyID body, math::Transform* transform, const JPH::BodyInterface& bodyInterface);
+        void Unbind(JPH::BodyID body);
+
+        // after every step, what was current becomes previous for every active body
+        void Capture(const JPH::PhysicsSystem& system, job::WorkerPool* workers = nullptr);
+        // writes the state at alpha between the last two steps into every transform that moved
+        void Apply(float alpha, job::WorkerPool* workers = nullptr);
+
+        uint32_t Size() const { return static_cast<uint32_t>(bodies.size() - freeSlots.size()); }
+        const BodySyncStats& GetStats() const { return stats; }
+    };
+}
+
+#endif //INTERPOLATEDBODIES_H
@@ -0,0 +1,50 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "PhysicsSimulation.h"
+
+#include <algorithm>
+#include <thread>
+#include <Jolt/Physics/PhysicsSettings.h>
+#include <spdlog/spdlog.h>
+
+namespace me::physics {
+    constexpr JPH::BroadPhaseLayer BROAD_PHASE_STATIC(0);
+    constexpr JPH::BroadPhaseLayer BROAD_PHASE_MOVING(1);
+
+    JPH::BroadPhaseLayer SimulationBroadPhaseLayers::GetBroadPhaseLayer(JPH::ObjectLayer layer) const {
+        return layer == SIMULATION_LAYER_STATIC ? BROAD_PHASE_STATIC : BROAD_PHASE_MOVING;
+    }
+
+#if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
+    const char* SimulationBroadPhaseLayers::GetBroadPhaseLayerName(JPH::BroadPhaseLayer layer) const {
+        return layer == BROAD_PHASE_STATIC ? "Static" : "Moving";
+    }
+#endif
+
+    bool SimulationBroadPhaseFilter::ShouldCollide(JPH::ObjectLayer layer, JPH::BroadPhaseLayer broadPhaseLayer) const {
+        return layer != SIMULATION_LAYER_STATIC || broadPhaseLayer == BROAD_PHASE_MOVING;
+    }
+
+    bool SimulationLayerFilter::ShouldCollide(JPH::ObjectLayer first, JPH::ObjectLayer second) const {
+        return first != SIMULATION_LAYER_STATIC || second != SIMULATION_LAYER_STATIC;
+    }
+
+    PhysicsSimulation::PhysicsSimulation(uint32_t maxBodies, uint32_t threads) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency()) - 1;
+        tempAllocator = std::make_unique<JPH::TempAllocatorImpl>(16 * 1024 * 1024);
+        jobSystem = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, static_cast<int>(threads));
+        // 0 body mutexes lets Jolt pick
+        system.Init(maxBodies, 0, maxBodies, maxBodies / 2, broadPhaseLayers, broadPhaseFilter, layerFilter);
+    }
+
+    bool PhysicsSimulation::Step(float seconds, int collisionSteps) {
+        JPH::EPhysicsUpdateError error = system.Update(seconds, collisionSteps, tempAllocator.get(), jobSystem.get());
+        if (error != JPH::EPhysicsUpdateError::None) {
+            spdlog::error("Physics step failed with error flags {}", static_cast<uint32_t>(error));
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,67 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef PHYSICSSIMULATION_H
+#define PHYSICSSIMULATION_H
+
+#include <cstdint>
+#include <memory>
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/TempAllocator.h>
+#include <Jolt/Physics/Collision/BroadPhase/BroadPhaseLayer.h>
+#include <Jolt/Physics/Collision/ObjectLayer.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+
+namespace me::physics {
+    // object layers of bodies in a PhysicsSimulation, static bodies never collide with each other
+    constexpr JPH::ObjectLayer SIMULATION_LAYER_STATIC = 0;
+    constexpr JPH::ObjectLayer SIMULATION_LAYER_MOVING = 1;
+
+    class SimulationBroadPhaseLayers : public JPH::BroadPhaseLayerInterface {
+        public:
+        JPH::uint GetNumBroadPhaseLayers() const override { return 2; }
+        JPH::BroadPhaseLayer GetBroadPhaseLayer(JPH::ObjectLayer layer) const override;
+#if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
+        const char* GetBroadPhaseLayerName(JPH::BroadPhaseLayer layer) const override;
+#endif
+    };
+
+    class SimulationBroadPhaseFilter : public JPH::ObjectVsBroadPhaseLayerFilter {
+        public:
+        bool ShouldCollide(JPH::ObjectLayer layer, JPH::BroadPhaseLayer broadPhaseLayer) const override;
+    };
+
+    class SimulationLayerFilter : public JPH::ObjectLayerPairFilter {
+        public:
+        bool ShouldCollide(JPH::ObjectLayer first, JPH::ObjectLayer second) const override;
+    };
+
+    // a Jolt world the app owns and steps itself, so the fixed stepper decides when it moves.
+    // the scene's PhysicsWorld is stepped once per frame inside SceneSystem::Update and can't be told not to,
+    // so bodies that should run on fixed steps live here instead. Jolt has to be set up already, me::Initialize does that
+    class PhysicsSimulation {
+        private:
+        SimulationBroadPhaseLayers broadPhaseLayers;
+        SimulationBroadPhaseFilter broadPhaseFilter;
+        SimulationLayerFilter layerFilter;
+        std::unique_ptr<JPH::TempAllocatorImpl> tempAllocator;
+        std::unique_ptr<JPH::JobSystemThreadPool> jobSystem;
+        JPH::PhysicsSystem system;
+
+        public:
+        // 0 threads uses one less than the hardware has, the stepping thread helps too
+        PhysicsSimulation(uint32_t maxBodies = 65536, uint32_t threads = 0);
+
+        // false if Jolt reported a problem, the step still ran
+        bool Step(float seconds, int collisionSteps = 1);
+
+        JPH::PhysicsSystem& GetSystem() { return system; }
+        const JPH::PhysicsSystem& GetSystem() const { return system; }
+        // the locking one
+        JPH::BodyInterface& GetInterface() { return system.GetBodyInterface(); }
+    };
+}
+
+#endif //PHYSICSSIMULATION_H
@@ -0,0 +1,80 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "DrawKey.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace me::render {
+    uint64_t MakeDrawKey(uint32_t material, uint32_t format, uint32_t mesh, uint32_t lod, float depth) {
+        // positive floats sort the same as their bit patterns, the top bits are a log scale depth bucket
+        depth = std::max(depth, 0.0f);
+        uint32_t depthBits;
+        memcpy(&depthBits, &depth, sizeof(float));
+        uint64_t depthBucket = depthBits >> (32 - DRAWKEY_DEPTH_BITS);
+
+        uint64_t materialBits = material & ((1u << DRAWKEY_MATERIAL_BITS) - 1);
+        uint64_t formatBits = format & ((1u << DRAWKEY_FORMAT_BITS) - 1);
+        uint64_t meshBits = mesh & ((1u << DRAWKEY_MESH_BITS) - 1);
+        uint64_t lodBits = lod & ((1u << DRAWKEY_LOD_BITS) - 1);
+
+        int shift = DRAWKEY_DEPTH_BITS;
+        uint64_t key = depthBucket | (lodBits << shift);
+        shift += DRAWKEY_LOD_BITS;
+        key |= meshBits << shift;
+        shift += DRAWKEY_MESH_BITS;
+        key |= formatBits << shift;
+        shift += DRAWKEY_FORMAT_BITS;
+        return key | (materialBits << shift);
+    }
+
+    void RadixSort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values,
+                   std::vector<uint64_t>& scratchKeys, std::vector<uint32_t>& scratchValues) {
+        const size_t count = keys.size();
+        if (count < 2) return;
+
+        scratchKeys.resize(count);
+        scratchValues.resize(count);
+
+        // one histogram per byte, built in a single read of the keys
+        uint32_t histograms[8][256] = {};
+        for (uint64_t key : keys) {
+            for (int pass = 0; pass < 8; pass++) {
+                histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+            }
+        }
+
+        uint64_t* srcKeys = keys.data();
+        uint32_t* srcValues = values.data();
+        uint64_t* dstKeys = scratchKeys.data();
+        uint32_t* dstValues = scratchValues.data();
+
+        for (int pass = 0; pass < 8; pass++) {
+            uint32_t* histogram = histograms[pass];
+            if (histogram[(srcKeys[0] >> (pass * 8)) & 0xFF] == count) continue;
+
+            uint32_t offset = 0;
+            for (int digit = 0; digit < 256; digit++) {
+                uint32_t amount = histogram[digit];
+                histogram[digit] = offset;
+                offset += amount;
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                uint32_t slot = histogram[(srcKeys[i] >> (pass * 8)) & 0xFF]++;
+                dstKeys[slot] = srcKeys[i];
+                dstValues[slot] = srcValues[i];
+            }
+
+            std::swap(srcKeys, dstKeys);
+            std::swap(srcValues, dstValues);
+        }
+
+        if (srcKeys != keys.data()) {
+            keys.swap(scratchKeys);
+            values.swap(scratchValues);
+        }
+    }
+}
@@ -0,0 +1,43 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef DRAWKEY_H
+#define DRAWKEY_H
+
+#include <cstdint>
+#include <vector>
+
+namespace me::render {
+    // 64 bit draw sort key, most significant first:
+    // [16 material][2 format][19 mesh][3 lod][24 depth]
+    // sorting groups draws by pipeline then geometry, and orders each group front to back.
+    // the format is the vertex format with the index format above it, so draws that bind the same buffers stay together
+    constexpr int DRAWKEY_DEPTH_BITS = 24;
+    constexpr int DRAWKEY_LOD_BITS = 3;
+    constexpr int DRAWKEY_MESH_BITS = 19;
+    constexpr int DRAWKEY_FORMAT_BITS = 2;
+    constexpr int DRAWKEY_MATERIAL_BITS = 16;
+
+    uint64_t MakeDrawKey(uint32_t material, uint32_t format, uint32_t mesh, uint32_t lod, float depth);
+
+    inline uint32_t DrawKeyMaterial(uint64_t key) {
+        return static_cast<uint32_t>(key >> (DRAWKEY_DEPTH_BITS + DRAWKEY_LOD_BITS + DRAWKEY_MESH_BITS + DRAWKEY_FORMAT_BITS));
+    }
+
+    inline uint32_t DrawKeyLod(uint64_t key) {
+        return static_cast<uint32_t>(key >> DRAWKEY_DEPTH_BITS) & ((1u << DRAWKEY_LOD_BITS) - 1);
+    }
+
+    // everything above the depth, equal state means the draws can share binds and one instanced call
+    inline uint64_t DrawKeyState(uint64_t key) {
+        return key >> DRAWKEY_DEPTH_BITS;
+    }
+
+    // lsd radix sort of keys with their payload, 8 bits per pass.
+    // passes where every key has the same digit are skipped, scratch buffers are reused between calls
+    void RadixSort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values,
+                   std::vector<uint64_t>& scratchKeys, std::vector<uint32_t>& scratchValues);
+}
+
+#endif //DRAWKEY_H
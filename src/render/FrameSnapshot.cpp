@@ -0,0 +1,132 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "FrameSnapshot.h"
+
+#include <algorithm>
+#include <SDL3/SDL.h>
+
+namespace me::render {
+    // how often the throughput numbers are recomputed
+    constexpr uint64_t THROUGHPUT_WINDOW_NS = 1000000000;
+
+    FrameQueue::FrameQueue(uint32_t depth) {
+        SetDepth(depth);
+    }
+
+    void FrameQueue::SetDepth(uint32_t depth) {
+        std::lock_guard lock(mutex);
+        this->depth = std::max(depth, 1u);
+        while (allocated < this->depth) {
+            free.push_back(std::make_unique<FrameSnapshot>());
+            allocated++;
+        }
+        while (allocated > this->depth && !free.empty()) {
+            free.pop_back();
+            allocated--;
+        }
+        stats.depth = this->depth;
+        changed.notify_all();
+    }
+
+    uint32_t FrameQueue::GetDepth() {
+        std::lock_guard lock(mutex);
+        return depth;
+    }
+
+    std::unique_ptr<FrameSnapshot> FrameQueue::BeginWrite() {
+        uint64_t start = SDL_GetTicksNS();
+        std::unique_lock lock(mutex);
+        changed.wait(lock, [this] { return closed || !free.empty(); });
+        stats.produceWaitNanoseconds = SDL_GetTicksNS() - start;
+        if (closed) return nullptr;
+
+        std::unique_ptr<FrameSnapshot> snapshot = std::move(free.back());
+        free.pop_back();
+        return snapshot;
+    }
+
+    void FrameQueue::Publish(std::unique_ptr<FrameSnapshot> snapshot) {
+        {
+            std::lock_guard lock(mutex);
+            ready.push_back(std::move(snapshot));
+            windowProduced++;
+        }
+        changed.notify_all();
+    }
+
+    std::unique_ptr<FrameSnapshot> FrameQueue::BeginRead() {
+        uint64_t start = SDL_GetTicksNS();
+        std::unique_lock lock(mutex);
+        changed.wait(lock, [this] { return closed || !ready.empty(); });
+        uint64_t now = SDL_GetTicksNS();
+        stats.consumeWaitNanoseconds = now - start;
+        if (ready.empty()) return nullptr;
+
+        std::unique_ptr<FrameSnapshot> snapshot = std::move(ready.front());
+        ready.pop_front();
+        stats.latencyNanoseconds = now - snapshot->captureTicks;
+        return snapshot;
+    }
+
+    std::unique_ptr<FrameSnapshot> FrameQueue::TryRead() {
+        std::lock_guard lock(mutex);
+        if (ready.empty()) return nullptr;
+
+        std::unique_ptr<FrameSnapshot> snapshot = std::move(ready.front());
+        ready.pop_front();
+        stats.consumeWaitNanoseconds = 0;
+        stats.latencyNanoseconds = SDL_GetTicksNS() - snapshot->captureTicks;
+        return snapshot;
+    }
+
+    void FrameQueue::Release(std::unique_ptr<FrameSnapshot> snapshot) {
+        // drawn, so the meshes removed in this step can go
+        snapshot->removedMeshes.clear();
+        {
+            std::lock_guard lock(mutex);
+            windowConsumed++;
+            if (allocated > depth) {
+                allocated--;
+            } else {
+                free.push_back(std::move(snapshot));
+            }
+
+            uint64_t now = SDL_GetTicksNS();
+            if (now - windowStart >= THROUGHPUT_WINDOW_NS) {
+                float seconds = static_cast<float>(now - windowStart) / 1e9f;
+                stats.producedPerSecond = static_cast<float>(windowProduced) / seconds;
+                stats.consumedPerSecond = static_cast<float>(windowConsumed) / seconds;
+                windowStart = now;
+                windowProduced = 0;
+                windowConsumed = 0;
+            }
+        }
+        changed.notify_all();
+    }
+
+    void FrameQueue::Close() {
+        {
+            std::lock_guard lock(mutex);
+            closed = true;
+        }
+        changed.notify_all();
+    }
+
+    void FrameQueue::Reopen() {
+        std::lock_guard lock(mutex);
+        closed = false;
+    }
+
+    uint32_t FrameQueue::GetQueued() {
+        std::lock_guard lock(mutex);
+        return static_cast<uint32_t>(ready.size());
+    }
+
+    FrameQueueStats FrameQueue::GetStats() {
+        std::lock_guard lock(mutex);
+        stats.queued = static_cast<uint32_t>(ready.size());
+        return stats;
+    }
+}
@@ -0,0 +1,114 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef FRAMESNAPSHOT_H
+#define FRAMESNAPSHOT_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "asset/Material.h"
+#include "asset/Mesh.h"
+#include "math/Transform.h"
+#include "RenderList.h"
+
+namespace me::render {
+    // everything the renderer reads from the scene for one frame, copied out of the render list at the end of a simulation step.
+    // the renderer never touches the scene, so the next step can run while this one is drawn.
+    // changes are relative to the previous snapshot, snapshots have to be rendered in order and none skipped.
+    // meshes and materials are only referenced. the render list keeps everything in it alive,
+    // and a mesh it lets go of rides along in removedMeshes, so it outlives every snapshot that could still draw it
+    struct FrameSnapshot {
+        uint64_t frame;
+        // SDL_GetTicksNS when it was captured, and how long that took
+        uint64_t captureTicks;
+        uint64_t captureNanoseconds;
+
+        math::PackedMatrix4x4 view;
+        math::PackedMatrix4x4 proj;
+        float fov;
+
+        // dense render list arrays, see RenderList
+        std::vector<asset::Mesh*> meshes;
+        std::vector<asset::Material*> materials;
+        std::vector<uint32_t> meshIds;
+        std::vector<uint32_t> materialIds;
+        std::vector<math::PackedMatrix4x4> models;
+        std::vector<RenderHandle> handles;
+        // handle slots in use or freed so far, anything indexed by slot fits in this many
+        uint32_t handleCount;
+        // dense indices whose matrix or slot changed since the previous snapshot
+        std::vector<uint32_t> changed;
+
+        std::vector<asset::Mesh*> newMeshes;
+        // parallel to newMeshes
+        std::vector<uint32_t> newMeshIds;
+        // the last references to these, dropped when the snapshot is released
+        std::vector<asset::MeshPtr> removedMeshes;
+    };
+
+    struct FrameQueueStats {
+        uint32_t depth;
+        // captured and waiting to be drawn
+        uint32_t queued;
+        // capture to the start of drawing, for the last snapshot read
+        uint64_t latencyNanoseconds;
+        // time the simulation waited for a free snapshot and the renderer for a ready one, last frame each
+        uint64_t produceWaitNanoseconds;
+        uint64_t consumeWaitNanoseconds;
+        // snapshots captured and drawn per second, over the last second
+        float producedPerSecond;
+        float consumedPerSecond;
+    };
+
+    // hands snapshots from the simulation to the renderer, first in first out.
+    // only depth snapshots exist, so the simulation runs at most depth - 1 frames ahead before it waits.
+    // snapshots are recycled, their arrays keep their capacity
+    class FrameQueue {
+        private:
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::vector<std::unique_ptr<FrameSnapshot>> free;
+        std::deque<std::unique_ptr<FrameSnapshot>> ready;
+        uint32_t depth = 0;
+        // free, ready and handed out
+        uint32_t allocated = 0;
+        bool closed = false;
+
+        FrameQueueStats stats = {};
+        uint64_t windowStart = 0;
+        uint32_t windowProduced = 0;
+        uint32_t windowConsumed = 0;
+
+        public:
+        FrameQueue(uint32_t depth);
+
+        // at least 1, extra snapshots are dropped as they come back
+        void SetDepth(uint32_t depth);
+        uint32_t GetDepth();
+
+        // blocks until a snapshot is free, null once closed
+        std::unique_ptr<FrameSnapshot> BeginWrite();
+        void Publish(std::unique_ptr<FrameSnapshot> snapshot);
+
+        // blocks until a snapshot is ready, null once closed and drained
+        std::unique_ptr<FrameSnapshot> BeginRead();
+        // null if nothing is ready
+        std::unique_ptr<FrameSnapshot> TryRead();
+        void Release(std::unique_ptr<FrameSnapshot> snapshot);
+
+        // wakes everything blocked and makes the calls above return null, for stopping the simulation thread
+        void Close();
+        void Reopen();
+
+        uint32_t GetQueued();
+        FrameQueueStats GetStats();
+    };
+}
+
+#endif //FRAMESNAPSHOT_H
@@ -0,0 +1,180 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "FrustumCuller.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "MeshGeometry.h"
+#include "RenderMath.h"
+#include "../debug/Profiler.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ME_CULL_SSE 1
+#endif
+
+namespace me::render {
+    // slots per chunk when culling on workers, a multiple of 4 so chunks line up with the simd groups
+    constexpr uint32_t CULL_GRAIN = 2048;
+
+    const AABB& FrustumCuller::GetMeshBounds(const asset::Mesh* mesh) {
+        auto found = meshBounds.find(mesh);
+        if (found != meshBounds.end()) return found->second;
+
+        MeshGeometryPtr geometry = GetMeshGeometry(mesh);
+        AABB bounds;
+        if (geometry->hasBounds) {
+            memcpy(bounds.min, geometry->boundsMin, sizeof(bounds.min));
+            memcpy(bounds.max, geometry->boundsMax, sizeof(bounds.max));
+        } else {
+            MeshGeometry computed = *geometry;
+            ComputeBounds(computed);
+            memcpy(bounds.min, computed.boundsMin, sizeof(bounds.min));
+            memcpy(bounds.max, computed.boundsMax, sizeof(bounds.max));
+        }
+        return meshBounds.emplace(mesh, bounds).first->second;
+    }
+
+    void FrustumCuller::ForgetMesh(const asset::Mesh* mesh) {
+        meshBounds.erase(mesh);
+    }
+
+    void FrustumCuller::SetViewProjection(const float* view, const float* proj) {
+        MultiplyMatrix(proj, view, clip);
+
+        // gribb/hartmann, clip space z is [0, 1] on every SDL_gpu backend
+        const int rows[6] = { 0, 0, 1, 1, 2, 2 };
+        const float signs[6] = { 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f };
+        for (int p = 0; p < 6; p++) {
+            for (int col = 0; col < 4; col++) {
+                float w = MatrixAt(clip, 3, col);
+                float axis = MatrixAt(clip, rows[p], col);
+                // near plane is just z >= 0
+                planes[p][col] = p == 4 ? axis : w + signs[p] * axis;
+            }
+            planes[p][3] *= VERTEX_W;
+        }
+    }
+
+    float FrustumCuller::GetDepth(uint32_t slot) const {
+        const float center[3] = { centerX[slot], centerY[slot], centerZ[slot] };
+        return std::fabs(ClipW(clip, center));
+    }
+
+    float FrustumCuller::GetRadius(uint32_t slot) const {
+        return std::sqrt(extentX[slot] * extentX[slot] + extentY[slot] * extentY[slot] + extentZ[slot] * extentZ[slot]);
+    }
+
+    void FrustumCuller::Resize(uint32_t slots) {
+        size_t padded = (slots + 3) & ~3u;
+        for (auto* lane : { &centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ }) {
+            lane->resize(padded);
+        }
+        count = slots;
+    }
+
+    void FrustumCuller::Set(uint32_t slot, const AABB& local, const float* model) {
+        float center[3], extent[3];
+        for (int i = 0; i < 3; i++) {
+            center[i] = (local.min[i] + local.max[i]) * 0.5f;
+            extent[i] = (local.max[i] - local.min[i]) * 0.5f;
+        }
+
+        // arvo: rotate the center, abs the linear part for the extent
+        float worldCenter[3], worldExtent[3];
+        for (int row = 0; row < 3; row++) {
+            worldCenter[row] = MatrixAt(model, row, 3) * VERTEX_W;
+            worldExtent[row] = 0.0f;
+            for (int col = 0; col < 3; col++) {
+                worldCenter[row] += MatrixAt(model, row, col) * center[col];
+                worldExtent[row] += std::fabs(MatrixAt(model, row, col)) * extent[col];
+            }
+        }
+
+        centerX[slot] = worldCenter[0];
+        centerY[slot] = worldCenter[1];
+        centerZ[slot] = worldCenter[2];
+        extentX[slot] = worldExtent[0];
+        extentY[slot] = worldExtent[1];
+        extentZ[slot] = worldExtent[2];
+    }
+
+    void FrustumCuller::CullRange(uint32_t begin, uint32_t end, std::vector<uint32_t>& visible) const {
+#ifdef ME_CULL_SSE
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        for (uint32_t base = begin; base < end; base += 4) {
+            const __m128 cx = _mm_loadu_ps(&centerX[base]);
+            const __m128 cy = _mm_loadu_ps(&centerY[base]);
+            const __m128 cz = _mm_loadu_ps(&centerZ[base]);
+            const __m128 ex = _mm_loadu_ps(&extentX[base]);
+            const __m128 ey = _mm_loadu_ps(&extentY[base]);
+            const __m128 ez = _mm_loadu_ps(&extentZ[base]);
+
+            __m128 outside = _mm_setzero_ps();
+            for (const float* plane : planes) {
+                const __m128 nx = _mm_set1_ps(plane[0]);
+                const __m128 ny = _mm_set1_ps(plane[1]);
+                const __m128 nz = _mm_set1_ps(plane[2]);
+
+                __m128 dist = _mm_add_ps(_mm_mul_ps(nx, cx), _mm_set1_ps(plane[3]));
+                dist = _mm_add_ps(dist, _mm_mul_ps(ny, cy));
+                dist = _mm_add_ps(dist, _mm_mul_ps(nz, cz));
+
+                __m128 radius = _mm_mul_ps(_mm_andnot_ps(signMask, nx), ex);
+                radius = _mm_add_ps(radius, _mm_mul_ps(_mm_andnot_ps(signMask, ny), ey));
+                radius = _mm_add_ps(radius, _mm_mul_ps(_mm_andnot_ps(signMask, nz), ez));
+
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dist, radius), _mm_setzero_ps()));
+            }
+
+            int mask = ~_mm_movemask_ps(outside) & 0xF;
+            for (uint32_t lane = 0; lane < 4 && base + lane < end; lane++) {
+                if (mask & (1 << lane)) visible.push_back(base + lane);
+            }
+        }
+#else
+        for (uint32_t i = begin; i < end; i++) {
+            bool inside = true;
+            for (const float* plane : planes) {
+                float dist = plane[0] * centerX[i] + plane[1] * centerY[i] + plane[2] * centerZ[i] + plane[3];
+                float radius = std::fabs(plane[0]) * extentX[i] + std::fabs(plane[1]) * extentY[i] + std::fabs(plane[2]) * extentZ[i];
+                if (dist + radius < 0.0f) {
+                    inside = false;
+                    break;
+                }
+            }
+            if (inside) visible.push_back(i);
+        }
+#endif
+    }
+
+    void FrustumCuller::Cull(std::vector<uint32_t>& visible, job::WorkerPool* workers) {
+        ME_PROFILE_SCOPE("Cull");
+        visible.clear();
+
+        if (workers == nullptr) {
+            CullRange(0, count, visible);
+        } else {
+            uint32_t chunks = (count + CULL_GRAIN - 1) / CULL_GRAIN;
+            if (chunkVisible.size() < chunks) chunkVisible.resize(chunks);
+
+            workers->ParallelFor(count, CULL_GRAIN, [this](uint32_t begin, uint32_t end, uint32_t) {
+                std::vector<uint32_t>& out = chunkVisible[begin / CULL_GRAIN];
+                out.clear();
+                CullRange(begin, end, out);
+            });
+
+            for (uint32_t chunk = 0; chunk < chunks; chunk++) {
+                visible.insert(visible.end(), chunkVisible[chunk].begin(), chunkVisible[chunk].end());
+            }
+        }
+
+        stats.tested = count;
+        stats.visible = static_cast<uint32_t>(visible.size());
+        stats.culled = count - stats.visible;
+    }
+}
@@ -0,0 +1,70 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef FRUSTUMCULLER_H
+#define FRUSTUMCULLER_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "asset/Mesh.h"
+#include "../job/WorkerPool.h"
+
+namespace me::render {
+    struct AABB {
+        float min[3];
+        float max[3];
+    };
+
+    struct CullStats {
+        uint32_t tested;
+        uint32_t visible;
+        uint32_t culled;
+    };
+
+    // culls world space bounds against the camera frustum.
+    // bounds are kept as packed SoA arrays (center/extent per axis) so four boxes get tested per plane at once.
+    class FrustumCuller {
+        private:
+        std::unordered_map<const asset::Mesh*, AABB> meshBounds;
+
+        // indexed by slot and padded to a multiple of 4, padding entries are never reported visible
+        std::vector<float> centerX, centerY, centerZ;
+        std::vector<float> extentX, extentY, extentZ;
+        uint32_t count = 0;
+
+        float clip[16] = {};
+        // xyz = normal, w = distance, already scaled for VERTEX_W
+        float planes[6][4] = {};
+        CullStats stats = {};
+        std::vector<std::vector<uint32_t>> chunkVisible;
+
+        // begin is a multiple of 4
+        void CullRange(uint32_t begin, uint32_t end, std::vector<uint32_t>& visible) const;
+
+        public:
+        // local space bounds of a mesh, computed the first time a mesh is seen (normally at upload).
+        // safe to call from several threads only for meshes that were already seen
+        const AABB& GetMeshBounds(const asset::Mesh* mesh);
+        void ForgetMesh(const asset::Mesh* mesh);
+
+        void SetViewProjection(const float* view, const float* proj);
+
+        // slots are persistent, only objects that moved need Set again
+        void Resize(uint32_t slots);
+        // transforms local bounds by a model matrix and packs the world space result into a slot
+        void Set(uint32_t slot, const AABB& local, const float* model);
+        // writes the slot of every box touching the frustum into visible, in slot order
+        void Cull(std::vector<uint32_t>& visible, job::WorkerPool* workers = nullptr);
+        // distance from the camera to the center of a slot's bounds, as clip space w
+        float GetDepth(uint32_t slot) const;
+        // radius of the sphere around a slot's world space bounds
+        float GetRadius(uint32_t slot) const;
+
+        const CullStats& GetStats() const { return stats; }
+    };
+}
+
+#endif //FRUSTUMCULLER_H
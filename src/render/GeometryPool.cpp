@@ -0,0 +1,287 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "GeometryPool.h"
+
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+#include "render/RenderGlobals.h"
+
+namespace me::render {
+    void RangeAllocator::Insert(uint32_t offset, uint32_t size) {
+        freeByOffset.emplace(offset, size);
+        freeBySize.emplace(size, offset);
+    }
+
+    void RangeAllocator::Erase(std::map<uint32_t, uint32_t>::iterator block) {
+        auto [first, last] = freeBySize.equal_range(block->second);
+        for (auto it = first; it != last; ++it) {
+            if (it->second == block->first) {
+                freeBySize.erase(it);
+                break;
+            }
+        }
+        freeByOffset.erase(block);
+    }
+
+    void RangeAllocator::Reset(uint32_t capacity) {
+        freeByOffset.clear();
+        freeBySize.clear();
+        this->capacity = capacity;
+        used = 0;
+        if (capacity > 0) Insert(0, capacity);
+    }
+
+    void RangeAllocator::Grow(uint32_t newCapacity) {
+        if (newCapacity <= capacity) return;
+        uint32_t oldCapacity = capacity;
+        capacity = newCapacity;
+        // counts as a free, so it merges with a free block at the old end
+        used += newCapacity - oldCapacity;
+        Free(oldCapacity, newCapacity - oldCapacity);
+    }
+
+    bool RangeAllocator::Allocate(uint32_t size, uint32_t& offset) {
+        if (size == 0) {
+            offset = 0;
+            return true;
+        }
+
+        auto fit = freeBySize.lower_bound(size);
+        if (fit == freeBySize.end()) return false;
+
+        offset = fit->second;
+        uint32_t blockSize = fit->first;
+        Erase(freeByOffset.find(offset));
+        if (blockSize > size) Insert(offset + size, blockSize - size);
+        used += size;
+        return true;
+    }
+
+    void RangeAllocator::Free(uint32_t offset, uint32_t size) {
+        if (size == 0) return;
+        used -= size;
+
+        auto next = freeByOffset.lower_bound(offset);
+        if (next != freeByOffset.end() && offset + size == next->first) {
+            size += next->second;
+            Erase(next);
+        }
+
+        auto previous = freeByOffset.lower_bound(offset);
+        if (previous != freeByOffset.begin()) {
+            --previous;
+            if (previous->first + previous->second == offset) {
+                offset = previous->first;
+                size += previous->second;
+                Erase(previous);
+            }
+        }
+
+        Insert(offset, size);
+    }
+
+    GeometryPool::GeometryPool(uint32_t vertexCapacity, uint32_t indexCapacity) {
+        vertices = { nullptr, SDL_GPU_BUFFERUSAGE_VERTEX, GetVertexStride(VertexFormat::Float3), 1, "GeometryPoolVertices", {} };
+        quantizedVertices = { nullptr, SDL_GPU_BUFFERUSAGE_VERTEX, GetVertexStride(VertexFormat::UNorm16), 1, "GeometryPoolQuantizedVertices", {} };
+        indices16 = { nullptr, SDL_GPU_BUFFERUSAGE_INDEX, sizeof(uint16_t), 2, "GeometryPoolIndices16", {} };
+        indices32 = { nullptr, SDL_GPU_BUFFERUSAGE_INDEX, sizeof(uint32_t), 1, "GeometryPoolIndices32", {} };
+        // an odd capacity would leave the end of the buffer, and everything a grow adds after it, off by 2 bytes
+        indexCapacity = GetReserved(indices16, indexCapacity);
+
+        if (CreateBuffer(vertices, vertexCapacity)) vertices.allocator.Reset(vertexCapacity);
+        // only meshes imported with quantization land here, it grows once they show up
+        if (CreateBuffer(quantizedVertices, vertexCapacity / 16)) quantizedVertices.allocator.Reset(vertexCapacity / 16);
+        if (CreateBuffer(indices16, indexCapacity)) indices16.allocator.Reset(indexCapacity);
+        // 32 bit meshes are rare, that buffer starts small and grows on demand
+        if (CreateBuffer(indices32, indexCapacity / 16)) indices32.allocator.Reset(indexCapacity / 16);
+    }
+
+    GeometryPool::~GeometryPool() {
+        for (SDL_GPUBuffer* buffer : retired) SDL_ReleaseGPUBuffer(render::mainDevice, buffer);
+        for (const Arena* arena : { &vertices, &quantizedVertices, &indices16, &indices32 }) {
+            if (arena->buffer) SDL_ReleaseGPUBuffer(render::mainDevice, arena->buffer);
+        }
+    }
+
+    bool GeometryPool::CreateBuffer(Arena& arena, uint32_t elements) {
+        SDL_GPUBufferCreateInfo info = {
+            .usage = arena.usage,
+            .size = elements * arena.stride
+        };
+        SDL_GPUBuffer* buffer = SDL_CreateGPUBuffer(render::mainDevice, &info);
+        if (buffer == nullptr) {
+            spdlog::error("Failed to create {} with {} bytes: {}", arena.name, info.size, SDL_GetError());
+            return false;
+        }
+        SDL_SetGPUBufferName(render::mainDevice, buffer, arena.name);
+        arena.buffer = buffer;
+        return true;
+    }
+
+    bool GeometryPool::Grow(Arena& arena, uint32_t minimumElements) {
+        SDL_GPUBuffer* old = arena.buffer;
+        uint32_t oldCapacity = arena.allocator.GetCapacity();
+        uint32_t newCapacity = std::max(oldCapacity * 2, oldCapacity + minimumElements);
+        if (!CreateBuffer(arena, newCapacity)) return false;
+
+        // a buffer made earlier this frame hasn't been written yet, point its pending copy at the new one and drop it
+        bool fresh = false;
+        for (Relocation& relocation : relocations) {
+            if (relocation.destination == old) {
+                relocation.destination = arena.buffer;
+                fresh = true;
+            }
+        }
+        if (fresh) {
+            SDL_ReleaseGPUBuffer(render::mainDevice, old);
+        } else if (old) {
+            relocations.push_back({ old, arena.buffer, 0, 0, oldCapacity * arena.stride });
+            retired.push_back(old);
+            relocationCount++;
+        }
+
+        arena.allocator.Grow(newCapacity);
+        return true;
+    }
+
+    const GeometryAllocation* GeometryPool::Allocate(const asset::Mesh* mesh, uint32_t vertexCount, uint32_t indexCount,
+                                                     IndexFormat indexFormat, VertexFormat vertexFormat) {
+        Free(mesh);
+
+        Arena& vertexArena = GetVertexArena(vertexFormat);
+        Arena& indices = GetIndexArena(indexFormat);
+        GeometryAllocation allocation = { 0, vertexCount, 0, indexCount, indexFormat, vertexFormat };
+        if (!vertexArena.allocator.Allocate(vertexCount, allocation.vertexOffset)) {
+            if (!Grow(vertexArena, vertexCount) || !vertexArena.allocator.Allocate(vertexCount, allocation.vertexOffset)) return nullptr;
+        }
+        uint32_t indexReserved = GetReserved(indices, indexCount);
+        if (!indices.allocator.Allocate(indexReserved, allocation.indexOffset)) {
+            if (!Grow(indices, indexReserved) || !indices.allocator.Allocate(indexReserved, allocation.indexOffset)) {
+                vertexArena.allocator.Free(allocation.vertexOffset, vertexCount);
+                return nullptr;
+            }
+        }
+
+        return &allocations.emplace(mesh, allocation).first->second;
+    }
+
+    void GeometryPool::Free(const asset::Mesh* mesh) {
+        auto found = allocations.find(mesh);
+        if (found == allocations.end()) return;
+
+        GetVertexArena(found->second.vertexFormat).allocator.Free(found->second.vertexOffset, found->second.vertexCount);
+        Arena& indices = GetIndexArena(found->second.indexFormat);
+        indices.allocator.Free(found->second.indexOffset, GetReserved(indices, found->second.indexCount));
+        allocations.erase(found);
+    }
+
+    const GeometryAllocation* GeometryPool::Find(const asset::Mesh* mesh) const {
+        auto found = allocations.find(mesh);
+        return found == allocations.end() ? nullptr : &found->second;
+    }
+
+    bool GeometryPool::NeedsDefragment() const {
+        for (const Arena* arena : { &vertices, &quantizedVertices, &indices16, &indices32 }) {
+            const RangeAllocator& allocator = arena->allocator;
+            uint32_t free = allocator.GetCapacity() - allocator.GetUsed();
+            if (allocator.GetFreeBlocks() > 16 && free > allocator.GetCapacity() / 4 && allocator.GetLargestFree() < free / 2) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void GeometryPool::Defragment() {
+        // chaining two moves of the same buffer in one frame isn't worth the hazard, wait for the pending ones
+        if (!relocations.empty()) return;
+
+        std::vector<GeometryAllocation*> live;
+        live.reserve(allocations.size());
+
+        auto compact = [this, &live](Arena& arena, uint32_t GeometryAllocation::* offset, uint32_t GeometryAllocation::* count) {
+            SDL_GPUBuffer* old = arena.buffer;
+            uint32_t capacity = arena.allocator.GetCapacity();
+            if (!CreateBuffer(arena, capacity)) return;
+
+            std::sort(live.begin(), live.end(), [offset](GeometryAllocation* a, GeometryAllocation* b) { return a->*offset < b->*offset; });
+
+            uint32_t cursor = 0;
+            for (GeometryAllocation* allocation : live) {
+                // the padding moves along, so copy sizes stay 4 byte multiples too
+                uint32_t reserved = GetReserved(arena, allocation->*count);
+                uint32_t size = reserved * arena.stride;
+                uint32_t source = allocation->*offset * arena.stride;
+                uint32_t destination = cursor * arena.stride;
+
+                // ranges that were already back to back move with one copy
+                Relocation* last = relocations.empty() ? nullptr : &relocations.back();
+                if (last && last->destination == arena.buffer && last->sourceOffset + last->size == source && last->destinationOffset + last->size == destination) {
+                    last->size += size;
+                } else if (size > 0) {
+                    relocations.push_back({ old, arena.buffer, source, destination, size });
+                }
+
+                allocation->*offset = cursor;
+                cursor += reserved;
+            }
+
+            retired.push_back(old);
+            arena.allocator.Reset(capacity);
+            uint32_t packed;
+            arena.allocator.Allocate(cursor, packed);
+        };
+
+        for (VertexFormat format : { VertexFormat::Float3, VertexFormat::UNorm16 }) {
+            live.clear();
+            for (auto& [mesh, allocation] : allocations) {
+                if (allocation.vertexFormat == format) live.push_back(&allocation);
+            }
+            compact(GetVertexArena(format), &GeometryAllocation::vertexOffset, &GeometryAllocation::vertexCount);
+        }
+
+        for (IndexFormat format : { IndexFormat::UInt16, IndexFormat::UInt32 }) {
+            live.clear();
+            for (auto& [mesh, allocation] : allocations) {
+                if (allocation.indexFormat == format) live.push_back(&allocation);
+            }
+            compact(GetIndexArena(format), &GeometryAllocation::indexOffset, &GeometryAllocation::indexCount);
+        }
+        relocationCount++;
+    }
+
+    void GeometryPool::RecordRelocations(SDL_GPUCommandBuffer* commandBuffer) {
+        if (relocations.empty()) return;
+
+        SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+        for (const Relocation& relocation : relocations) {
+            SDL_GPUBufferLocation source = { relocation.source, relocation.sourceOffset };
+            SDL_GPUBufferLocation destination = { relocation.destination, relocation.destinationOffset };
+            SDL_CopyGPUBufferToBuffer(copyPass, &source, &destination, relocation.size, false);
+        }
+        SDL_EndGPUCopyPass(copyPass);
+
+        // released buffers stay alive until the commands using them are done
+        for (SDL_GPUBuffer* buffer : retired) SDL_ReleaseGPUBuffer(render::mainDevice, buffer);
+        retired.clear();
+        relocations.clear();
+    }
+
+    GeometryPoolStats GeometryPool::GetStats() const {
+        GeometryPoolStats stats = {};
+        for (const Arena* arena : { &vertices, &quantizedVertices }) {
+            stats.vertexBytesUsed += arena->allocator.GetUsed() * arena->stride;
+            stats.vertexBytesCapacity += arena->allocator.GetCapacity() * arena->stride;
+            stats.freeBlocks += arena->allocator.GetFreeBlocks();
+        }
+        for (const Arena* arena : { &indices16, &indices32 }) {
+            stats.indexBytesUsed += arena->allocator.GetUsed() * arena->stride;
+            stats.indexBytesCapacity += arena->allocator.GetCapacity() * arena->stride;
+            stats.freeBlocks += arena->allocator.GetFreeBlocks();
+        }
+        stats.relocations = relocationCount;
+        return stats;
+    }
+}
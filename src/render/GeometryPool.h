@@ -0,0 +1,130 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef GEOMETRYPOOL_H
+#define GEOMETRYPOOL_H
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <SDL3/SDL.h>
+
+#include "asset/Mesh.h"
+#include "MeshGeometry.h"
+
+namespace me::render {
+    // best fit free list over a range of elements, neighbours are merged on free
+    class RangeAllocator {
+        private:
+        std::map<uint32_t, uint32_t> freeByOffset;
+        std::multimap<uint32_t, uint32_t> freeBySize;
+        uint32_t capacity = 0;
+        uint32_t used = 0;
+
+        void Insert(uint32_t offset, uint32_t size);
+        void Erase(std::map<uint32_t, uint32_t>::iterator block);
+
+        public:
+        void Reset(uint32_t capacity);
+        // adds space at the end
+        void Grow(uint32_t newCapacity);
+
+        bool Allocate(uint32_t size, uint32_t& offset);
+        void Free(uint32_t offset, uint32_t size);
+
+        uint32_t GetCapacity() const { return capacity; }
+        uint32_t GetUsed() const { return used; }
+        uint32_t GetFreeBlocks() const { return static_cast<uint32_t>(freeByOffset.size()); }
+        uint32_t GetLargestFree() const { return freeBySize.empty() ? 0 : freeBySize.rbegin()->first; }
+    };
+
+    struct GeometryAllocation {
+        uint32_t vertexOffset;
+        uint32_t vertexCount;
+        uint32_t indexOffset;
+        uint32_t indexCount;
+        IndexFormat indexFormat;
+        VertexFormat vertexFormat;
+    };
+
+    // in bytes, over every vertex and index format
+    struct GeometryPoolStats {
+        uint32_t vertexBytesUsed;
+        uint32_t vertexBytesCapacity;
+        uint32_t indexBytesUsed;
+        uint32_t indexBytesCapacity;
+        uint32_t freeBlocks;
+        uint32_t relocations;
+    };
+
+    // every mesh's vertices and indices live in a few big shared buffers, a mesh is just a range in each.
+    // each vertex format and each index format gets its own buffers, a pass rebinds only when the format changes.
+    // draws address their range with first_index / vertex_offset, so the buffers are bound once per pass.
+    // growing and defragmenting move data gpu side, the copies are queued and recorded by RecordRelocations.
+    class GeometryPool {
+        private:
+        struct Arena {
+            SDL_GPUBuffer* buffer;
+            SDL_GPUBufferUsageFlags usage;
+            uint32_t stride;
+            // ranges are reserved in multiples of this many elements, so every one starts and ends 4 byte aligned.
+            // gpu copies need that, 16 bit indices reserve an even count
+            uint32_t granularity;
+            const char* name;
+            RangeAllocator allocator;
+        };
+
+        struct Relocation {
+            SDL_GPUBuffer* source;
+            SDL_GPUBuffer* destination;
+            uint32_t sourceOffset;
+            uint32_t destinationOffset;
+            uint32_t size;
+        };
+
+        Arena vertices;
+        Arena quantizedVertices;
+        Arena indices16;
+        Arena indices32;
+        std::unordered_map<const asset::Mesh*, GeometryAllocation> allocations;
+        std::vector<Relocation> relocations;
+        std::vector<SDL_GPUBuffer*> retired;
+        uint32_t relocationCount = 0;
+
+        static uint32_t GetReserved(const Arena& arena, uint32_t count) { return (count + arena.granularity - 1) / arena.granularity * arena.granularity; }
+        bool CreateBuffer(Arena& arena, uint32_t elements);
+        bool Grow(Arena& arena, uint32_t minimumElements);
+        Arena& GetVertexArena(VertexFormat format) { return format == VertexFormat::UNorm16 ? quantizedVertices : vertices; }
+        const Arena& GetVertexArena(VertexFormat format) const { return format == VertexFormat::UNorm16 ? quantizedVertices : vertices; }
+        Arena& GetIndexArena(IndexFormat format) { return format == IndexFormat::UInt32 ? indices32 : indices16; }
+        const Arena& GetIndexArena(IndexFormat format) const { return format == IndexFormat::UInt32 ? indices32 : indices16; }
+
+        public:
+        // capacities are for the common formats, the others start smaller
+        GeometryPool(uint32_t vertexCapacity, uint32_t indexCapacity);
+        ~GeometryPool();
+
+        // reserves ranges for a mesh, growing the buffers if there's no room.
+        // a 16 bit index range with an odd count gets one more index of padding behind it
+        const GeometryAllocation* Allocate(const asset::Mesh* mesh, uint32_t vertexCount, uint32_t indexCount,
+                                           IndexFormat indexFormat, VertexFormat vertexFormat);
+        void Free(const asset::Mesh* mesh);
+        const GeometryAllocation* Find(const asset::Mesh* mesh) const;
+
+        // packs every live range to the start of fresh buffers
+        void Defragment();
+        bool NeedsDefragment() const;
+        bool HasPendingRelocations() const { return !relocations.empty(); }
+
+        // records queued grow/defragment copies, must run before anything else writes to the pool this frame
+        void RecordRelocations(SDL_GPUCommandBuffer* commandBuffer);
+
+        SDL_GPUBuffer* GetVertexBuffer(VertexFormat format) const { return GetVertexArena(format).buffer; }
+        SDL_GPUBuffer* GetIndexBuffer(IndexFormat format) const { return GetIndexArena(format).buffer; }
+        GeometryPoolStats GetStats() const;
+    };
+}
+
+#endif //GEOMETRYPOOL_H
@@ -0,0 +1,57 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "LodSelector.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace me::render {
+    const std::vector<MeshLod>& LodSelector::GetMeshLods(const asset::Mesh* mesh) {
+        auto found = meshLods.find(mesh);
+        if (found != meshLods.end()) return found->second;
+
+        MeshGeometryPtr geometry = GetMeshGeometry(mesh);
+        std::vector<MeshLod> lods = geometry->lods;
+        if (lods.empty()) lods.push_back({ 0, geometry->indexCount, 0.0f });
+        if (lods.size() > MAX_MESH_LODS) lods.resize(MAX_MESH_LODS);
+        return meshLods.emplace(mesh, std::move(lods)).first->second;
+    }
+
+    void LodSelector::ForgetMesh(const asset::Mesh* mesh) {
+        meshLods.erase(mesh);
+    }
+
+    void LodSelector::SetView(float fovDegrees, float viewportHeight) {
+        float halfFov = std::clamp(fovDegrees, 1.0f, 179.0f) * 0.5f * 3.14159265f / 180.0f;
+        pixelsPerUnit = viewportHeight * 0.5f / std::tan(halfFov);
+    }
+
+    uint32_t LodSelector::Coarsest(const std::vector<MeshLod>& lods, float pixels) const {
+        for (uint32_t level = static_cast<uint32_t>(lods.size()) - 1; level > 0; level--) {
+            if (lods[level].error * pixels <= errorPixels) return level;
+        }
+        return 0;
+    }
+
+    uint32_t LodSelector::Select(const std::vector<MeshLod>& lods, float radius, float depth, uint8_t& current) const {
+        if (forcedLod >= 0) {
+            current = static_cast<uint8_t>(std::min<size_t>(forcedLod, lods.size() - 1));
+            return current;
+        }
+
+        // pixels the object's radius spans on screen, the errors are relative to it
+        float pixels = radius * pixelsPerUnit / std::max(depth, 1e-4f);
+        uint32_t needed = Coarsest(lods, pixels);
+        uint32_t allowed = Coarsest(lods, pixels * (1.0f + hysteresis));
+
+        // finer levels are taken right away, coarser ones only once they'd still pass with the margin
+        if (current >= lods.size() || needed < current) {
+            current = static_cast<uint8_t>(needed);
+        } else if (allowed > current) {
+            current = static_cast<uint8_t>(allowed);
+        }
+        return current;
+    }
+}
@@ -0,0 +1,60 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef LODSELECTOR_H
+#define LODSELECTOR_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "asset/Mesh.h"
+#include "MeshGeometry.h"
+
+namespace me::render {
+    // an object that hasn't been given a level yet
+    constexpr uint8_t NO_LOD = UINT8_MAX;
+
+    // picks a level of detail per object from how many pixels its simplification error would cover on screen.
+    // an object only moves to a coarser level once it's a margin past the switch point,
+    // so objects sitting right at a threshold don't flicker between two levels
+    class LodSelector {
+        private:
+        std::unordered_map<const asset::Mesh*, std::vector<MeshLod>> meshLods;
+
+        // screen pixels covered by one unit at one unit of depth
+        float pixelsPerUnit = 0.0f;
+        float errorPixels = 1.0f;
+        float hysteresis = 0.25f;
+        int forcedLod = -1;
+
+        // coarsest level whose error stays under errorPixels at this pixel scale
+        uint32_t Coarsest(const std::vector<MeshLod>& lods, float pixels) const;
+
+        public:
+        // levels of a mesh, looked up the first time a mesh is seen (normally at upload).
+        // safe to call from several threads only for meshes that were already seen
+        const std::vector<MeshLod>& GetMeshLods(const asset::Mesh* mesh);
+        void ForgetMesh(const asset::Mesh* mesh);
+
+        // fovDegrees is the vertical field of view
+        void SetView(float fovDegrees, float viewportHeight);
+
+        // updates current (the object's level last frame) and returns it.
+        // radius is the world space bounding radius, depth the view distance to its center
+        uint32_t Select(const std::vector<MeshLod>& lods, float radius, float depth, uint8_t& current) const;
+
+        // how much error is allowed on screen, higher trades detail for triangles
+        void SetErrorPixels(float pixels) { errorPixels = pixels; }
+        float GetErrorPixels() const { return errorPixels; }
+        // fraction further an object has to go before it drops a level
+        void SetHysteresis(float fraction) { hysteresis = fraction; }
+        float GetHysteresis() const { return hysteresis; }
+        // -1 selects by screen size, anything else pins every object to that level (or its coarsest)
+        void SetForcedLod(int lod) { forcedLod = lod; }
+        int GetForcedLod() const { return forcedLod; }
+    };
+}
+
+#endif //LODSELECTOR_H
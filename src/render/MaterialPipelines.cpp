@@ -0,0 +1,169 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "MaterialPipelines.h"
+
+#include <spdlog/spdlog.h>
+
+#include "render/RenderGlobals.h"
+#include "render/Window.h"
+
+namespace me::render {
+    // shader compiles are long and mostly single threaded, two keep a handful of materials moving
+    constexpr uint32_t PIPELINE_BUILD_THREADS = 2;
+
+    static SDL_GPUGraphicsPipeline* BuildPipeline(const MaterialSources& sources, VertexFormat format) {
+        ShaderBytecode vertexCode;
+        ShaderBytecode fragmentCode;
+        if (!CompileShaderBytecode(*sources.vertex, vertexCode) || !CompileShaderBytecode(*sources.fragment, fragmentCode)) return nullptr;
+
+        SDL_GPUShader* vertexShader = CreateShader(vertexCode);
+        SDL_GPUShader* fragmentShader = CreateShader(fragmentCode);
+        SDL_GPUGraphicsPipeline* pipeline = nullptr;
+        if (vertexShader && fragmentShader) pipeline = CreateMeshPipeline(vertexShader, fragmentShader, format);
+        // the pipeline keeps what it needs
+        if (vertexShader) SDL_ReleaseGPUShader(render::mainDevice, vertexShader);
+        if (fragmentShader) SDL_ReleaseGPUShader(render::mainDevice, fragmentShader);
+        return pipeline;
+    }
+
+    MaterialPipelines::MaterialPipelines() : builder(std::make_unique<job::TaskQueue>(PIPELINE_BUILD_THREADS)) {}
+
+    MaterialPipelines::~MaterialPipelines() {
+        // lets running builds finish first, they report into finished
+        builder.reset();
+        for (const Finished& result : finished) {
+            if (result.pipeline) SDL_ReleaseGPUGraphicsPipeline(render::mainDevice, result.pipeline);
+        }
+        for (auto& [key, pipeline] : built) {
+            if (pipeline) SDL_ReleaseGPUGraphicsPipeline(render::mainDevice, pipeline);
+        }
+    }
+
+    void MaterialPipelines::Build(const Key& key, MaterialSources sources) {
+        uint32_t generation = nextGeneration++;
+        building[key] = generation;
+        builder->Submit([this, key, generation, sources = std::move(sources)] {
+            SDL_GPUGraphicsPipeline* pipeline = BuildPipeline(sources, key.second);
+            std::lock_guard lock(finishedMutex);
+            finished.push_back({ key, generation, pipeline });
+        });
+    }
+
+    void MaterialPipelines::Update() {
+        TakeReloadedMaterials(reloaded);
+        for (const asset::Material* material : reloaded) {
+            MaterialSources sources;
+            if (!GetMaterialSources(material, sources)) continue;
+            // every format this material was used with, built or still building
+            std::set<Key> keys;
+            for (const auto& [key, pipeline] : built) {
+                if (key.first == material) keys.insert(key);
+            }
+            for (const auto& [key, generation] : building) {
+                if (key.first == material) keys.insert(key);
+            }
+            for (const Key& key : keys) Build(key, sources);
+        }
+        reloaded.clear();
+
+        std::vector<Finished> results;
+        {
+            std::lock_guard lock(finishedMutex);
+            results.swap(finished);
+        }
+
+        for (const Finished& result : results) {
+            // forgotten while it was building, or superseded by a newer build
+            auto latest = building.find(result.key);
+            if (latest == building.end() || latest->second != result.generation) {
+                if (result.pipeline) SDL_ReleaseGPUGraphicsPipeline(render::mainDevice, result.pipeline);
+                continue;
+            }
+            building.erase(latest);
+
+            auto current = built.find(result.key);
+            if (current == built.end()) {
+                built.emplace(result.key, result.pipeline);
+            } else if (result.pipeline) {
+                // the device holds on to the old one until the frames using it are done
+                if (current->second) SDL_ReleaseGPUGraphicsPipeline(render::mainDevice, current->second);
+                current->second = result.pipeline;
+                spdlog::info("Reloaded a material pipeline");
+            } else if (current->second) {
+                spdlog::warn("Reloaded shaders failed to build, keeping the previous pipeline");
+            }
+        }
+    }
+
+    SDL_GPUGraphicsPipeline* MaterialPipelines::Get(asset::Material* material, VertexFormat format) {
+        Key key = std::make_pair(static_cast<const asset::Material*>(material), format);
+        auto found = built.find(key);
+        if (found != built.end()) return found->second;
+        if (building.contains(key)) return nullptr;
+
+        MaterialSources sources;
+        if (!GetMaterialSources(material, sources)) {
+            if (format == VertexFormat::Float3) {
+                if (material->GetPipeline() == nullptr) material->CreateGPUPipeline();
+                return material->GetPipeline();
+            }
+            spdlog::error("Material has no registered shader sources, its quantized meshes won't draw");
+            built.emplace(key, nullptr);
+            return nullptr;
+        }
+
+        Build(key, std::move(sources));
+        return nullptr;
+    }
+
+    void MaterialPipelines::Forget(const asset::Material* material) {
+        for (auto it = built.begin(); it != built.end();) {
+            if (it->first.first == material) {
+                if (it->second) SDL_ReleaseGPUGraphicsPipeline(render::mainDevice, it->second);
+                it = built.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        std::erase_if(building, [material](const auto& entry) { return entry.first.first == material; });
+    }
+
+    SDL_GPUGraphicsPipeline* CreateMeshPipeline(SDL_GPUShader* vertexShader, SDL_GPUShader* fragmentShader, VertexFormat format) {
+        SDL_GPUColorTargetDescription colorTarget = {};
+        colorTarget.format = SDL_GetGPUSwapchainTextureFormat(render::mainDevice, render::mainWindow->GetWindow());
+
+        SDL_GPUVertexBufferDescription vertexBuffer = {};
+        vertexBuffer.slot = 0;
+        vertexBuffer.pitch = GetVertexStride(format);
+        vertexBuffer.input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX;
+
+        // unorm positions arrive in the shader as 0..1, the instance transform scales them back out to the bounds.
+        // the fourth component is padding, POSITION only reads xyz
+        SDL_GPUVertexAttribute position = {};
+        position.location = 0;
+        position.buffer_slot = 0;
+        position.format = format == VertexFormat::UNorm16 ? SDL_GPU_VERTEXELEMENTFORMAT_USHORT4_NORM : SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3;
+        position.offset = 0;
+
+        SDL_GPUGraphicsPipelineCreateInfo info = {};
+        info.vertex_shader = vertexShader;
+        info.fragment_shader = fragmentShader;
+        info.vertex_input_state.num_vertex_buffers = 1;
+        info.vertex_input_state.vertex_buffer_descriptions = &vertexBuffer;
+        info.vertex_input_state.num_vertex_attributes = 1;
+        info.vertex_input_state.vertex_attributes = &position;
+        info.primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
+        info.rasterizer_state.fill_mode = SDL_GPU_FILLMODE_FILL;
+        info.rasterizer_state.cull_mode = SDL_GPU_CULLMODE_NONE;
+        info.rasterizer_state.front_face = SDL_GPU_FRONTFACE_COUNTER_CLOCKWISE;
+        info.multisample_state.sample_count = SDL_GPU_SAMPLECOUNT_1;
+        info.target_info.num_color_targets = 1;
+        info.target_info.color_target_descriptions = &colorTarget;
+
+        SDL_GPUGraphicsPipeline* pipeline = SDL_CreateGPUGraphicsPipeline(render::mainDevice, &info);
+        if (pipeline == nullptr) spdlog::error("Failed to create mesh pipeline: {}", SDL_GetError());
+        return pipeline;
+    }
+}
@@ -0,0 +1,66 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef MATERIALPIPELINES_H
+#define MATERIALPIPELINES_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+#include <SDL3/SDL.h>
+
+#include "asset/Material.h"
+#include "MeshGeometry.h"
+#include "ShaderCompiler.h"
+#include "../job/TaskQueue.h"
+
+namespace me::render {
+    // the pipeline a material draws a vertex format with, built from the material's registered shader sources.
+    // builds run on their own threads and are picked up by Update, until then the material doesn't draw.
+    // materials whose sources were reloaded are rebuilt the same way and swapped in by Update, a failed rebuild keeps the old pipeline.
+    // materials without registered sources fall back to their own pipeline, which only takes Float3
+    class MaterialPipelines {
+        private:
+        typedef std::pair<const asset::Material*, VertexFormat> Key;
+
+        struct Finished {
+            Key key;
+            uint32_t generation;
+            SDL_GPUGraphicsPipeline* pipeline;
+        };
+
+        // null entries are pipelines that failed to build, they aren't retried until their sources change
+        std::map<Key, SDL_GPUGraphicsPipeline*> built;
+        // generation of the latest build started for a key, results of older ones are dropped
+        std::map<Key, uint32_t> building;
+        uint32_t nextGeneration = 0;
+        std::vector<const asset::Material*> reloaded;
+        std::mutex finishedMutex;
+        std::vector<Finished> finished;
+        std::unique_ptr<job::TaskQueue> builder;
+
+        void Build(const Key& key, MaterialSources sources);
+
+        public:
+        MaterialPipelines();
+        ~MaterialPipelines();
+
+        // starts rebuilds for reloaded materials and swaps in pipelines finished since the last call.
+        // once at the start of a frame, so a frame never mixes old and new pipelines
+        void Update();
+        // null until the pipeline is built or if it can't be, failures are logged once per material and format
+        SDL_GPUGraphicsPipeline* Get(asset::Material* material, VertexFormat format);
+        // drops pipelines built for a material, builds still running for it are thrown away
+        void Forget(const asset::Material* material);
+        uint32_t GetBuilding() const { return static_cast<uint32_t>(building.size()); }
+    };
+
+    // a pipeline for drawing pool geometry of the given format into the swapchain, null and logged on failure
+    SDL_GPUGraphicsPipeline* CreateMeshPipeline(SDL_GPUShader* vertexShader, SDL_GPUShader* fragmentShader, VertexFormat format);
+}
+
+#endif //MATERIALPIPELINES_H
@@ -0,0 +1,87 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "MeshGeometry.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace me::render {
+    static std::mutex registryMutex;
+    static std::unordered_map<const asset::Mesh*, MeshGeometryPtr> registry;
+
+    void MeshGeometry::GetPosition(uint32_t vertex, float out[3]) const {
+        if (vertexFormat == VertexFormat::UNorm16) {
+            for (int i = 0; i < 3; i++) {
+                float t = quantizedPositions[vertex * 4 + i] / 65535.0f;
+                out[i] = boundsMin[i] + (boundsMax[i] - boundsMin[i]) * t;
+            }
+        } else {
+            memcpy(out, &positions[vertex], sizeof(float) * 3);
+        }
+    }
+
+    template<typename T>
+    static bool IndicesInRange(const T* indices, uint32_t count, uint32_t vertexCount) {
+        for (uint32_t i = 0; i < count; i++) {
+            if (indices[i] >= vertexCount) return false;
+        }
+        return true;
+    }
+
+    bool MeshGeometry::IndicesInRange() const {
+        if (indexFormat == IndexFormat::UInt32) return render::IndicesInRange(static_cast<const uint32_t*>(indices), indexCount, vertexCount);
+        return render::IndicesInRange(static_cast<const uint16_t*>(indices), indexCount, vertexCount);
+    }
+
+    void ComputeBounds(MeshGeometry& geometry) {
+        // quantized positions are relative to the bounds, they can't tell us anything new
+        if (geometry.vertexFormat != VertexFormat::Float3) return;
+
+        for (int i = 0; i < 3; i++) {
+            geometry.boundsMin[i] = geometry.vertexCount ? FLT_MAX : 0.0f;
+            geometry.boundsMax[i] = geometry.vertexCount ? -FLT_MAX : 0.0f;
+        }
+        for (uint32_t vertex = 0; vertex < geometry.vertexCount; vertex++) {
+            const float* v = reinterpret_cast<const float*>(&geometry.positions[vertex]);
+            for (int i = 0; i < 3; i++) {
+                geometry.boundsMin[i] = std::fmin(geometry.boundsMin[i], v[i]);
+                geometry.boundsMax[i] = std::fmax(geometry.boundsMax[i], v[i]);
+            }
+        }
+        geometry.hasBounds = true;
+    }
+
+    void RegisterMeshGeometry(const asset::Mesh* mesh, MeshGeometryPtr geometry) {
+        std::lock_guard lock(registryMutex);
+        registry[mesh] = std::move(geometry);
+    }
+
+    void UnregisterMeshGeometry(const asset::Mesh* mesh) {
+        std::lock_guard lock(registryMutex);
+        registry.erase(mesh);
+    }
+
+    MeshGeometryPtr GetMeshGeometry(const asset::Mesh* mesh) {
+        {
+            std::lock_guard lock(registryMutex);
+            auto found = registry.find(mesh);
+            if (found != registry.end()) return found->second;
+        }
+
+        const auto& vertices = mesh->GetVertexBuffer();
+        const auto& indices = mesh->GetIndexBuffer();
+        auto geometry = std::make_shared<MeshGeometry>();
+        geometry->positions = vertices.data();
+        geometry->vertexCount = static_cast<uint32_t>(vertices.size());
+        geometry->indices = indices.data();
+        geometry->indexCount = static_cast<uint32_t>(indices.size());
+        geometry->indexFormat = IndexFormat::UInt16;
+        geometry->submeshes = { { 0, geometry->indexCount, 0 } };
+        return geometry;
+    }
+}
@@ -0,0 +1,97 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef MESHGEOMETRY_H
+#define MESHGEOMETRY_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "asset/Mesh.h"
+
+namespace me::render {
+    enum class IndexFormat : uint8_t {
+        UInt16,
+        UInt32
+    };
+
+    inline uint32_t GetIndexStride(IndexFormat format) {
+        return format == IndexFormat::UInt32 ? 4 : 2;
+    }
+
+    enum class VertexFormat : uint8_t {
+        // float xyz, what asset::Mesh holds
+        Float3,
+        // 16 bit unorm xyz plus padding, relative to the mesh bounds
+        UNorm16
+    };
+
+    inline uint32_t GetVertexStride(VertexFormat format) {
+        return format == VertexFormat::UNorm16 ? 4 * sizeof(uint16_t) : 3 * sizeof(float);
+    }
+
+    // a range of the mesh's indices drawn with one material slot
+    struct Submesh {
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        uint32_t materialSlot;
+    };
+
+    // levels a mesh can have, the draw key has 3 bits for it
+    constexpr uint32_t MAX_MESH_LODS = 8;
+
+    // a level of detail, a range of indices over the same vertices as the full mesh.
+    // error is how far the level strays from the full mesh, relative to the radius of its bounds
+    struct MeshLod {
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        float error;
+    };
+
+    // what the renderer uploads for a mesh.
+    // positions and indices are views, owner keeps whatever they point into alive
+    struct MeshGeometry {
+        // Float3 vertices, null for other formats
+        const math::PackedVector3* positions;
+        uint32_t vertexCount;
+        VertexFormat vertexFormat = VertexFormat::Float3;
+        // UNorm16 vertices, 4 per vertex. quantized geometry always has its bounds
+        const uint16_t* quantizedPositions = nullptr;
+        const void* indices;
+        uint32_t indexCount;
+        IndexFormat indexFormat;
+        std::vector<Submesh> submeshes;
+        // finest first, lods[0] is the full mesh. indexCount covers every level.
+        // empty means the mesh only has its full level, as every submesh together
+        std::vector<MeshLod> lods;
+        std::shared_ptr<const void> owner;
+        // local space bounds if the source already knew them, otherwise they're computed from the positions
+        bool hasBounds = false;
+        float boundsMin[3];
+        float boundsMax[3];
+
+        const void* GetVertexData() const { return vertexFormat == VertexFormat::UNorm16 ? static_cast<const void*>(quantizedPositions) : positions; }
+        uint32_t GetVertexBytes() const { return vertexCount * GetVertexStride(vertexFormat); }
+        // decoded position of a vertex in either format
+        void GetPosition(uint32_t vertex, float out[3]) const;
+        uint32_t GetIndexBytes() const { return indexCount * GetIndexStride(indexFormat); }
+        // false if an index points past the last vertex, the gpu and the culler must never see one
+        bool IndicesInRange() const;
+    };
+
+    typedef std::shared_ptr<const MeshGeometry> MeshGeometryPtr;
+
+    // fills in the bounds from the positions
+    void ComputeBounds(MeshGeometry& geometry);
+
+    // geometry that replaces a mesh's own 16 bit buffers, until unregistered.
+    // the registry is locked, loaders can register from any thread
+    void RegisterMeshGeometry(const asset::Mesh* mesh, MeshGeometryPtr geometry);
+    void UnregisterMeshGeometry(const asset::Mesh* mesh);
+    // the registered geometry, or a view of the mesh's own buffers as a single submesh
+    MeshGeometryPtr GetMeshGeometry(const asset::Mesh* mesh);
+}
+
+#endif //MESHGEOMETRY_H
@@ -0,0 +1,175 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "MeshUploadQueue.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "UploadRing.h"
+
+namespace me::render {
+    // smallest staging allocation worth making when the ring is busy
+    constexpr uint32_t MIN_STAGING_BYTES = 64 * 1024;
+
+    MeshUploadQueue::MeshUploadQueue(GeometryPool& pool, uint32_t bytesPerFrame) : pool(pool) {
+        SetBudget(bytesPerFrame);
+    }
+
+    void MeshUploadQueue::SetBudget(uint32_t bytesPerFrame) {
+        // a chunk has to fit in the ring next to whatever is still in flight
+        budget = std::max(MIN_STAGING_BYTES, bytesPerFrame);
+        if (mainUploadRing) budget = std::min(budget, mainUploadRing->GetCapacity() / 2);
+    }
+
+    bool MeshUploadQueue::Enqueue(asset::Mesh* mesh) {
+        auto found = entries.find(mesh);
+        if (found != entries.end()) return true;
+
+        MeshGeometryPtr geometry = GetMeshGeometry(mesh);
+        if (pool.Allocate(mesh, geometry->vertexCount, geometry->indexCount, geometry->indexFormat, geometry->vertexFormat) == nullptr) return false;
+
+        // an odd 16 bit index count is staged with a zero index of padding, the pool reserved room for it.
+        // that keeps every copy's size and offset a multiple of 4
+        uint32_t indexBytes = (geometry->GetIndexBytes() + 3) & ~3u;
+        pending.push_back({ mesh, geometry, geometry->GetVertexBytes(), indexBytes, 0 });
+        entries[mesh] = { MeshUploadState::Pending, 0 };
+        return true;
+    }
+
+    void MeshUploadQueue::Forget(const asset::Mesh* mesh) {
+        auto found = entries.find(mesh);
+        if (found == entries.end()) return;
+
+        if (found->second.state == MeshUploadState::Pending) {
+            std::erase_if(pending, [mesh](const Job& job) { return job.mesh == mesh; });
+        } else if (found->second.state == MeshUploadState::InFlight) {
+            std::erase(inFlight, mesh);
+        }
+        entries.erase(found);
+        pool.Free(mesh);
+    }
+
+    MeshUploadState MeshUploadQueue::GetState(const asset::Mesh* mesh) const {
+        auto found = entries.find(mesh);
+        return found == entries.end() ? MeshUploadState::None : found->second.state;
+    }
+
+    void MeshUploadQueue::AddCopy(std::vector<asset::MeshTransferSection>& uploads, const SDL_GPUTransferBufferLocation& source,
+                                  SDL_GPUBuffer* buffer, uint32_t offset, uint32_t size) {
+        if (size == 0) return;
+
+        if (!uploads.empty()) {
+            asset::MeshTransferSection& last = uploads.back();
+            bool sameSource = last.location.transfer_buffer == source.transfer_buffer && last.location.offset + last.region.size == source.offset;
+            bool sameDestination = last.region.buffer == buffer && last.region.offset + last.region.size == offset;
+            if (sameSource && sameDestination) {
+                last.region.size += size;
+                return;
+            }
+        }
+
+        uploads.push_back({ source, { buffer, offset, size } });
+        stats.copies++;
+    }
+
+    void MeshUploadQueue::Process(std::vector<asset::MeshTransferSection>& uploads) {
+        uint64_t start = SDL_GetTicksNS();
+        stats.bytesStaged = 0;
+        stats.copies = 0;
+
+        // frames retire in order, so the in flight list does too
+        uint64_t completedFrames = mainUploadRing->GetCompletedFrames();
+        while (!inFlight.empty()) {
+            Entry& entry = entries[inFlight.front()];
+            if (entry.frame > completedFrames) break;
+
+            entry.state = MeshUploadState::Resident;
+            inFlight.pop_front();
+        }
+
+        if (!pending.empty()) {
+            uint32_t want = 0;
+            for (const Job& job : pending) {
+                // worst case alignment padding for both streams
+                want += job.vertexBytes + job.indexBytes - job.staged + 8;
+                if (want >= budget) break;
+            }
+            want = std::min(want, budget);
+
+            UploadAllocation allocation = {};
+            while (!mainUploadRing->Allocate(want, 4, allocation)) {
+                want /= 2;
+                if (want < MIN_STAGING_BYTES) {
+                    allocation.size = 0;
+                    break;
+                }
+            }
+
+            uint64_t frame = mainUploadRing->GetSubmittedFrames() + 1;
+            uint32_t cursor = 0;
+            while (!pending.empty() && allocation.size > 0) {
+                Job& job = pending.front();
+                // looked up every frame, defragmenting can move the ranges between frames
+                const GeometryAllocation* range = pool.Find(job.mesh);
+                uint32_t vertexBase = range->vertexOffset * GetVertexStride(range->vertexFormat);
+                uint32_t indexBase = range->indexOffset * GetIndexStride(range->indexFormat);
+
+                // the mesh is staged as one stream, vertices then indices
+                struct Part {
+                    const uint8_t* data;
+                    // bytes data actually has, the rest of the part is padding
+                    uint32_t dataSize;
+                    SDL_GPUBuffer* buffer;
+                    uint32_t base;
+                    uint32_t begin;
+                    uint32_t end;
+                };
+                const Part parts[2] = {
+                    { static_cast<const uint8_t*>(job.geometry->GetVertexData()), job.vertexBytes, pool.GetVertexBuffer(range->vertexFormat),
+                      vertexBase, 0, job.vertexBytes },
+                    { static_cast<const uint8_t*>(job.geometry->indices), job.geometry->GetIndexBytes(), pool.GetIndexBuffer(range->indexFormat),
+                      indexBase, job.vertexBytes, job.vertexBytes + job.indexBytes }
+                };
+
+                for (const Part& part : parts) {
+                    if (job.staged >= part.end) continue;
+
+                    cursor = (cursor + 3) & ~3u;
+                    if (cursor >= allocation.size) break;
+
+                    uint32_t offset = std::max(job.staged, part.begin) - part.begin;
+                    uint32_t size = std::min(part.end - part.begin - offset, allocation.size - cursor);
+                    // a part cut short ends on a multiple of 4, so the next frame's piece starts aligned too
+                    if (size < part.end - part.begin - offset) size &= ~3u;
+                    if (size == 0) break;
+
+                    uint8_t* staging = static_cast<uint8_t*>(allocation.data) + cursor;
+                    uint32_t copied = offset < part.dataSize ? std::min(size, part.dataSize - offset) : 0;
+                    memcpy(staging, part.data + offset, copied);
+                    memset(staging + copied, 0, size - copied);
+                    SDL_GPUTransferBufferLocation source = { allocation.location.transfer_buffer, allocation.location.offset + cursor };
+                    AddCopy(uploads, source, part.buffer, part.base + offset, size);
+
+                    cursor += size;
+                    job.staged = part.begin + offset + size;
+                    stats.bytesStaged += size;
+                    if (job.staged < part.end) break;
+                }
+
+                if (job.staged < job.vertexBytes + job.indexBytes) break;
+
+                Entry& entry = entries[job.mesh];
+                entry.state = MeshUploadState::InFlight;
+                entry.frame = frame;
+                inFlight.push_back(job.mesh);
+                pending.pop_front();
+            }
+        }
+
+        stats.pending = static_cast<uint32_t>(pending.size());
+        stats.inFlight = static_cast<uint32_t>(inFlight.size());
+        stats.stageNanoseconds = SDL_GetTicksNS() - start;
+    }
+}
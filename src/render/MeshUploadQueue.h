@@ -0,0 +1,83 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef MESHUPLOADQUEUE_H
+#define MESHUPLOADQUEUE_H
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "asset/Mesh.h"
+#include "GeometryPool.h"
+
+namespace me::render {
+    enum class MeshUploadState {
+        None,
+        // waiting for budget, possibly partially staged
+        Pending,
+        // every byte is staged, waiting on the frame that copies it
+        InFlight,
+        // safe to draw
+        Resident
+    };
+
+    struct MeshUploadStats {
+        uint32_t bytesStaged;
+        uint32_t copies;
+        uint32_t pending;
+        uint32_t inFlight;
+        uint64_t stageNanoseconds;
+    };
+
+    // spreads mesh uploads over frames.
+    // each Process stages at most the byte budget into a single ring allocation, splitting big meshes across frames,
+    // and merges copies that are contiguous on both ends into one.
+    // meshes get their ranges in the geometry pool on Enqueue, before anything is staged for the frame
+    class MeshUploadQueue {
+        private:
+        struct Job {
+            asset::Mesh* mesh;
+            MeshGeometryPtr geometry;
+            uint32_t vertexBytes;
+            uint32_t indexBytes;
+            uint32_t staged;
+        };
+
+        struct Entry {
+            MeshUploadState state;
+            uint64_t frame;
+        };
+
+        GeometryPool& pool;
+        std::deque<Job> pending;
+        std::deque<asset::Mesh*> inFlight;
+        std::unordered_map<const asset::Mesh*, Entry> entries;
+        uint32_t budget;
+        MeshUploadStats stats = {};
+
+        void AddCopy(std::vector<asset::MeshTransferSection>& uploads, const SDL_GPUTransferBufferLocation& source,
+                     SDL_GPUBuffer* buffer, uint32_t offset, uint32_t size);
+
+        public:
+        MeshUploadQueue(GeometryPool& pool, uint32_t bytesPerFrame);
+
+        // false if the pool has no room for the mesh
+        bool Enqueue(asset::Mesh* mesh);
+        // drops a mesh that is going away, wherever it is in the queue, and frees its pool ranges
+        void Forget(const asset::Mesh* mesh);
+
+        MeshUploadState GetState(const asset::Mesh* mesh) const;
+
+        // stages pending work into mainUploadRing and appends the copies, call once per frame before recording them
+        void Process(std::vector<asset::MeshTransferSection>& uploads);
+
+        void SetBudget(uint32_t bytesPerFrame);
+        uint32_t GetBudget() const { return budget; }
+        const MeshUploadStats& GetStats() const { return stats; }
+    };
+}
+
+#endif //MESHUPLOADQUEUE_H
@@ -0,0 +1,204 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "RenderList.h"
+
+#include "scene/sceneobj/SceneMesh.h"
+
+namespace me::render {
+    // entries per chunk when Update runs on workers
+    constexpr uint32_t UPDATE_GRAIN = 1024;
+
+    void RenderList::AcquireMesh(const asset::MeshPtr& mesh) {
+        auto found = meshTable.find(mesh.get());
+        if (found != meshTable.end()) {
+            found->second.references++;
+            return;
+        }
+
+        uint32_t id;
+        if (!freeMeshIds.empty()) {
+            id = freeMeshIds.back();
+            freeMeshIds.pop_back();
+        } else {
+            id = nextMeshId++;
+        }
+        meshTable.emplace(mesh.get(), MeshEntry { id, 1, mesh });
+        newMeshes.push_back(mesh.get());
+    }
+
+    void RenderList::ReleaseMesh(asset::Mesh* mesh) {
+        auto found = meshTable.find(mesh);
+        if (found == meshTable.end()) return;
+        if (--found->second.references > 0) return;
+
+        freeMeshIds.push_back(found->second.id);
+        // a mesh added since the last snapshot was never drawn, nothing has to wait for it
+        if (std::erase(newMeshes, mesh) == 0) {
+            removedMeshes.push_back(std::move(found->second.mesh));
+        }
+        meshTable.erase(found);
+    }
+
+    uint32_t RenderList::GetMeshId(const asset::Mesh* mesh) const {
+        auto found = meshTable.find(const_cast<asset::Mesh*>(mesh));
+        return found == meshTable.end() ? UINT32_MAX : found->second.id;
+    }
+
+    uint32_t RenderList::GetMaterialId(const asset::MaterialPtr& material) {
+        auto found = materialTable.find(material.get());
+        if (found != materialTable.end()) return found->second.id;
+
+        uint32_t id = static_cast<uint32_t>(materialTable.size());
+        materialTable.emplace(material.get(), MaterialEntry { id, material });
+        return id;
+    }
+
+    uint32_t RenderList::Find(RenderHandle handle) const {
+        uint32_t slot = GetRenderHandleSlot(handle);
+        if (handle == INVALID_RENDER_HANDLE || slot >= handleToDense.size()) return UINT32_MAX;
+        if (generations[slot] != handle >> RENDER_HANDLE_SLOT_BITS) return UINT32_MAX;
+        return handleToDense[slot];
+    }
+
+    RenderHandle RenderList::Add(scene::SceneMesh* object, bool isStatic) {
+        if (object == nullptr || object->mesh == nullptr) return INVALID_RENDER_HANDLE;
+
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            // the last slot would collide with INVALID_RENDER_HANDLE
+            if (handleToDense.size() >= RENDER_HANDLE_SLOT_MASK) return INVALID_RENDER_HANDLE;
+            slot = static_cast<uint32_t>(handleToDense.size());
+            handleToDense.push_back(0);
+            generations.push_back(0);
+        }
+        RenderHandle handle = slot | static_cast<RenderHandle>(generations[slot]) << RENDER_HANDLE_SLOT_BITS;
+
+        const asset::MeshPtr& mesh = object->mesh;
+        const asset::MaterialPtr& material = object->material ? object->material : fallbackMaterial;
+        AcquireMesh(mesh);
+
+        handleToDense[slot] = Size();
+        denseToHandle.push_back(handle);
+        owners.push_back(object);
+        meshes.push_back(mesh.get());
+        materials.push_back(material.get());
+        meshIds.push_back(meshTable[mesh.get()].id);
+        materialIds.push_back(GetMaterialId(material));
+        models.emplace_back();
+        this->isStatic.push_back(isStatic);
+        dirty.push_back(true);
+        return handle;
+    }
+
+    void RenderList::Remove(RenderHandle handle) {
+        uint32_t index = Find(handle);
+        if (index == UINT32_MAX) return;
+        uint32_t last = Size() - 1;
+        ReleaseMesh(meshes[index]);
+
+        if (index != last) {
+            owners[index] = owners[last];
+            meshes[index] = meshes[last];
+            materials[index] = materials[last];
+            meshIds[index] = meshIds[last];
+            materialIds[index] = materialIds[last];
+            models[index] = models[last];
+            isStatic[index] = isStatic[last];
+            // moved entries land in a new dense slot, anything indexed by slot has to hear about it
+            dirty[index] = true;
+            denseToHandle[index] = denseToHandle[last];
+            handleToDense[GetRenderHandleSlot(denseToHandle[index])] = index;
+        }
+
+        owners.pop_back();
+        meshes.pop_back();
+        materials.pop_back();
+        meshIds.pop_back();
+        materialIds.pop_back();
+        models.pop_back();
+        isStatic.pop_back();
+        dirty.pop_back();
+        denseToHandle.pop_back();
+
+        uint32_t slot = GetRenderHandleSlot(handle);
+        generations[slot]++;
+        freeSlots.push_back(slot);
+    }
+
+    bool RenderList::Refresh(RenderHandle handle) {
+        uint32_t index = Find(handle);
+        if (index == UINT32_MAX) return false;
+
+        scene::SceneMesh* object = owners[index];
+        if (object->mesh == nullptr) {
+            Remove(handle);
+            return false;
+        }
+        if (object->mesh.get() != meshes[index]) {
+            AcquireMesh(object->mesh);
+            ReleaseMesh(meshes[index]);
+            meshes[index] = object->mesh.get();
+            meshIds[index] = meshTable[meshes[index]].id;
+        }
+        const asset::MaterialPtr& material = object->material ? object->material : fallbackMaterial;
+        materials[index] = material.get();
+        materialIds[index] = GetMaterialId(material);
+        dirty[index] = true;
+        return true;
+    }
+
+    void RenderList::MarkDirty(RenderHandle handle) {
+        uint32_t index = Find(handle);
+        if (index == UINT32_MAX) return;
+        dirty[index] = true;
+    }
+
+    void RenderList::Update(job::WorkerPool* workers) {
+        changed.clear();
+        if (workers == nullptr) {
+            for (uint32_t i = 0; i < Size(); i++) {
+                if (!isStatic[i] || dirty[i]) {
+                    owners[i]->GetTransform().Raw().ToTRS(true).StoreFloat4x4(models[i]);
+                    dirty[i] = false;
+                    changed.push_back(i);
+                }
+            }
+            return;
+        }
+
+        // one list per chunk rather than per worker keeps the merged result in order
+        uint32_t chunks = (Size() + UPDATE_GRAIN - 1) / UPDATE_GRAIN;
+        if (chunkChanged.size() < chunks) chunkChanged.resize(chunks);
+
+        workers->ParallelFor(Size(), UPDATE_GRAIN, [this](uint32_t begin, uint32_t end, uint32_t) {
+            std::vector<uint32_t>& out = chunkChanged[begin / UPDATE_GRAIN];
+            out.clear();
+            for (uint32_t i = begin; i < end; i++) {
+                if (!isStatic[i] || dirty[i]) {
+                    owners[i]->GetTransform().Raw().ToTRS(true).StoreFloat4x4(models[i]);
+                    dirty[i] = false;
+                    out.push_back(i);
+                }
+            }
+        });
+
+        for (uint32_t chunk = 0; chunk < chunks; chunk++) {
+            changed.insert(changed.end(), chunkChanged[chunk].begin(), chunkChanged[chunk].end());
+        }
+    }
+
+    void RenderList::TakeNewMeshes(std::vector<asset::Mesh*>& out) {
+        out.clear();
+        out.swap(newMeshes);
+    }
+
+    void RenderList::TakeRemovedMeshes(std::vector<asset::MeshPtr>& out) {
+        out.clear();
+        out.swap(removedMeshes);
+    }
+}
@@ -0,0 +1,120 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef RENDERLIST_H
+#define RENDERLIST_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "asset/Material.h"
+#include "asset/Mesh.h"
+#include "math/Transform.h"
+#include "../job/WorkerPool.h"
+
+namespace me::scene {
+    class SceneMesh;
+}
+
+namespace me::render {
+    // slot in the low bits, the slot's generation above it so a handle kept after Remove stops matching
+    typedef uint32_t RenderHandle;
+    constexpr RenderHandle INVALID_RENDER_HANDLE = UINT32_MAX;
+    constexpr uint32_t RENDER_HANDLE_SLOT_BITS = 24;
+    constexpr uint32_t RENDER_HANDLE_SLOT_MASK = (1u << RENDER_HANDLE_SLOT_BITS) - 1;
+
+    // for state kept per object, slots are dense from 0 and reused after removal
+    inline uint32_t GetRenderHandleSlot(RenderHandle handle) { return handle & RENDER_HANDLE_SLOT_MASK; }
+
+    // dense registry of everything the renderer draws.
+    // entries are stored SoA and swap removed, so the renderer walks flat arrays instead of the scene graph.
+    // dynamic entries have their matrix rebuilt every Update, static ones only after MarkDirty.
+    class RenderList {
+        private:
+        // the list keeps every mesh it references alive, a snapshot may still be drawing one the scene let go of
+        struct MeshEntry {
+            uint32_t id;
+            uint32_t references;
+            asset::MeshPtr mesh;
+        };
+
+        // materials are kept for as long as the list, their ids aren't reused either
+        struct MaterialEntry {
+            uint32_t id;
+            asset::MaterialPtr material;
+        };
+
+        std::vector<scene::SceneMesh*> owners;
+        std::vector<asset::Mesh*> meshes;
+        std::vector<asset::Material*> materials;
+        std::vector<uint32_t> meshIds;
+        std::vector<uint32_t> materialIds;
+        std::vector<math::PackedMatrix4x4> models;
+        std::vector<uint8_t> isStatic;
+        std::vector<uint8_t> dirty;
+
+        std::vector<RenderHandle> denseToHandle;
+        std::vector<uint32_t> handleToDense;
+        // per slot, bumped on Remove
+        std::vector<uint8_t> generations;
+        std::vector<uint32_t> freeSlots;
+
+        std::unordered_map<asset::Mesh*, MeshEntry> meshTable;
+        std::unordered_map<asset::Material*, MaterialEntry> materialTable;
+        std::vector<uint32_t> freeMeshIds;
+        uint32_t nextMeshId = 0;
+
+        std::vector<asset::Mesh*> newMeshes;
+        std::vector<asset::MeshPtr> removedMeshes;
+        std::vector<uint32_t> changed;
+        std::vector<std::vector<uint32_t>> chunkChanged;
+        asset::MaterialPtr fallbackMaterial;
+
+        void AcquireMesh(const asset::MeshPtr& mesh);
+        void ReleaseMesh(asset::Mesh* mesh);
+        uint32_t GetMaterialId(const asset::MaterialPtr& material);
+        // dense index of a live handle, UINT32_MAX for a stale or invalid one
+        uint32_t Find(RenderHandle handle) const;
+
+        public:
+        // used for objects that don't have a material of their own
+        void SetFallbackMaterial(asset::MaterialPtr material) { fallbackMaterial = std::move(material); }
+
+        RenderHandle Add(scene::SceneMesh* object, bool isStatic = false);
+        // stale handles are ignored
+        void Remove(RenderHandle handle);
+        // re-reads the mesh and material of an object after they were swapped out.
+        // an object left without a mesh is removed, false when that happened or the handle was stale
+        bool Refresh(RenderHandle handle);
+        // flags a static entry's transform for a rebuild
+        void MarkDirty(RenderHandle handle);
+
+        // rebuilds matrices for dynamic and dirty entries, their dense indices end up in GetChanged.
+        // with workers the entries are split in chunks, GetChanged stays in dense order either way
+        void Update(job::WorkerPool* workers = nullptr);
+
+        uint32_t Size() const { return static_cast<uint32_t>(meshes.size()); }
+        const std::vector<asset::Mesh*>& GetMeshes() const { return meshes; }
+        const std::vector<asset::Material*>& GetMaterials() const { return materials; }
+        const std::vector<uint32_t>& GetMeshIds() const { return meshIds; }
+        // id of a mesh something in the list references, ids are small and reused after the mesh goes away
+        uint32_t GetMeshId(const asset::Mesh* mesh) const;
+        const std::vector<uint32_t>& GetMaterialIds() const { return materialIds; }
+        const std::vector<math::PackedMatrix4x4>& GetModels() const { return models; }
+        const std::vector<uint32_t>& GetChanged() const { return changed; }
+        // handle of every dense entry, for state that has to follow an entry when it moves
+        const std::vector<RenderHandle>& GetHandles() const { return denseToHandle; }
+        // every handle's slot is below this
+        uint32_t GetHandleCount() const { return static_cast<uint32_t>(handleToDense.size()); }
+
+        // meshes referenced for the first time since the last call, the list is cleared by this call
+        void TakeNewMeshes(std::vector<asset::Mesh*>& out);
+        // meshes nothing references anymore, the list is cleared by this call.
+        // out holds the last references, whatever drew them drops those once it's done
+        void TakeRemovedMeshes(std::vector<asset::MeshPtr>& out);
+    };
+}
+
+#endif //RENDERLIST_H
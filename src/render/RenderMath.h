@@ -0,0 +1,53 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef RENDERMATH_H
+#define RENDERMATH_H
+
+#include <cmath>
+
+// small helpers over matrices stored with math::Matrix::StoreFloat4x4.
+// storage matches the column_major float4x4 the shaders read, so element (row, col) lives at m[col * 4 + row].
+namespace me::render {
+    // vertex.hlsl feeds positions in with w = -1, everything cpu side that reasons about
+    // where a vertex ends up has to do the same or it disagrees with the gpu.
+    constexpr float VERTEX_W = -1.0f;
+
+    inline float MatrixAt(const float* m, int row, int col) {
+        return m[col * 4 + row];
+    }
+
+    // out = a * b
+    inline void MultiplyMatrix(const float* a, const float* b, float* out) {
+        for (int col = 0; col < 4; col++) {
+            for (int row = 0; row < 4; row++) {
+                float sum = 0.0f;
+                for (int k = 0; k < 4; k++) {
+                    sum += MatrixAt(a, row, k) * MatrixAt(b, k, col);
+                }
+                out[col * 4 + row] = sum;
+            }
+        }
+    }
+
+    // out = model * a matrix taking unorm positions back to [boundsMin, boundsMax], under VERTEX_W.
+    // quantized vertices go through this instead of decoding in the shader
+    inline void DequantizeMatrix(const float* model, const float* boundsMin, const float* boundsMax, float* out) {
+        for (int row = 0; row < 4; row++) {
+            float translation = MatrixAt(model, row, 3);
+            for (int axis = 0; axis < 3; axis++) {
+                out[axis * 4 + row] = MatrixAt(model, row, axis) * (boundsMax[axis] - boundsMin[axis]);
+                translation += MatrixAt(model, row, axis) * boundsMin[axis] / VERTEX_W;
+            }
+            out[3 * 4 + row] = translation;
+        }
+    }
+
+    // transforms a point the way the vertex shader does and returns clip space w
+    inline float ClipW(const float* m, const float* point) {
+        return MatrixAt(m, 3, 0) * point[0] + MatrixAt(m, 3, 1) * point[1] + MatrixAt(m, 3, 2) * point[2] + MatrixAt(m, 3, 3) * VERTEX_W;
+    }
+}
+
+#endif //RENDERMATH_H
@@ -0,0 +1,346 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "ShaderCompiler.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <SDL3_shadercross/SDL_shadercross.h>
+#include <spdlog/spdlog.h>
+
+#include "render/RenderGlobals.h"
+#include "../util/Hash.h"
+
+namespace me::render {
+    struct ShaderCacheHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t key;
+        uint32_t format;
+        uint32_t stage;
+        uint32_t samplers;
+        uint32_t storageTextures;
+        uint32_t storageBuffers;
+        uint32_t uniformBuffers;
+        uint32_t entrypointLength;
+        uint32_t codeSize;
+    };
+
+    static std::mutex registryMutex;
+    static std::unordered_map<const asset::Material*, MaterialSources> registry;
+    static std::vector<const asset::Material*> reloaded;
+    static std::once_flag shadercrossInit;
+    static std::mutex cacheMutex;
+    static std::string cacheDirectory;
+
+    // the format compiled shaders are stored in for mainDevice
+    static SDL_GPUShaderFormat GetTargetFormat() {
+        SDL_GPUShaderFormat formats = SDL_GetGPUShaderFormats(render::mainDevice);
+        if (formats & SDL_GPU_SHADERFORMAT_SPIRV) return SDL_GPU_SHADERFORMAT_SPIRV;
+        if (formats & SDL_GPU_SHADERFORMAT_DXIL) return SDL_GPU_SHADERFORMAT_DXIL;
+        return SDL_GPU_SHADERFORMAT_SPIRV;
+    }
+
+    // appends every file the code includes, nested ones too, so editing an include misses the cache.
+    // names resolve against the including file's directory, then the source's include directory
+    static void AppendIncludes(const std::string& code, const std::filesystem::path& directory, const std::filesystem::path& includeDirectory,
+                               std::vector<std::filesystem::path>& visited, std::string& key) {
+        size_t position = 0;
+        while ((position = code.find("#include", position)) != std::string::npos) {
+            position += 8;
+            size_t open = code.find_first_of("\"<\n", position);
+            if (open == std::string::npos || code[open] == '\n') continue;
+            size_t close = code.find_first_of(code[open] == '<' ? ">\n" : "\"\n", open + 1);
+            if (close == std::string::npos || code[close] == '\n') continue;
+
+            std::filesystem::path name = code.substr(open + 1, close - open - 1);
+            std::error_code error;
+            std::filesystem::path path = directory / name;
+            if (!std::filesystem::exists(path, error)) path = includeDirectory / name;
+            path = std::filesystem::weakly_canonical(path, error);
+            if (std::find(visited.begin(), visited.end(), path) != visited.end()) continue;
+            visited.push_back(path);
+
+            key.push_back('\0');
+            std::ifstream in(path, std::ios::binary);
+            if (!in) {
+                // the compile reports it, the key only has to change once the file shows up
+                key += "missing " + name.string();
+                continue;
+            }
+            std::string included((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            key += included;
+            AppendIncludes(included, path.parent_path(), includeDirectory, visited, key);
+        }
+    }
+
+    static uint64_t GetCacheKey(const ShaderSource& source, SDL_GPUShaderFormat format) {
+        std::string key = source.code;
+        if (!source.includeDirectory.empty()) {
+            std::vector<std::filesystem::path> visited;
+            AppendIncludes(source.code, source.includeDirectory, source.includeDirectory, visited, key);
+        }
+        // a newer compiler can produce different bytecode from the same source
+        key += fmt::format("\0shadercross {}.{}.{}", SDL_SHADERCROSS_MAJOR_VERSION, SDL_SHADERCROSS_MINOR_VERSION, SDL_SHADERCROSS_MICRO_VERSION);
+        key.push_back('\0');
+        key += source.entrypoint;
+        key.push_back('\0');
+        key += std::to_string(static_cast<uint32_t>(source.stage));
+        key.push_back('\0');
+        key += std::to_string(format);
+        for (const auto& [name, value] : source.defines) {
+            key.push_back('\0');
+            key += name;
+            key.push_back('=');
+            key += value;
+        }
+        return util::HashBytes(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+    }
+
+    static bool ReadCachedShader(const std::string& nativePath, uint64_t key, ShaderBytecode& out) {
+        std::ifstream in(nativePath, std::ios::binary);
+        if (!in) return false;
+
+        ShaderCacheHeader header;
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+        if (header.magic != SHADER_CACHE_MAGIC || header.version != SHADER_CACHE_VERSION || header.key != key) return false;
+
+        out.format = header.format;
+        out.stage = static_cast<SDL_GPUShaderStage>(header.stage);
+        out.samplers = header.samplers;
+        out.storageTextures = header.storageTextures;
+        out.storageBuffers = header.storageBuffers;
+        out.uniformBuffers = header.uniformBuffers;
+        out.entrypoint.resize(header.entrypointLength);
+        out.code.resize(header.codeSize);
+        in.read(out.entrypoint.data(), header.entrypointLength);
+        in.read(reinterpret_cast<char*>(out.code.data()), header.codeSize);
+        // anything past the code means the file isn't what the header says
+        return in && in.peek() == std::ifstream::traits_type::eof();
+    }
+
+    static bool WriteCachedShader(const std::string& nativePath, uint64_t key, const ShaderBytecode& bytecode) {
+        ShaderCacheHeader header = {
+            SHADER_CACHE_MAGIC, SHADER_CACHE_VERSION, key, bytecode.format, static_cast<uint32_t>(bytecode.stage),
+            bytecode.samplers, bytecode.storageTextures, bytecode.storageBuffers, bytecode.uniformBuffers,
+            static_cast<uint32_t>(bytecode.entrypoint.size()), static_cast<uint32_t>(bytecode.code.size())
+        };
+
+        // written next to the target and renamed, the same shader may be compiled on two threads at once
+        std::string temporary = fmt::format("{}.{}.tmp", nativePath, SDL_GetCurrentThreadID());
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(bytecode.entrypoint.data(), static_cast<std::streamsize>(bytecode.entrypoint.size()));
+            out.write(reinterpret_cast<const char*>(bytecode.code.data()), static_cast<std::streamsize>(bytecode.code.size()));
+            if (!out) {
+                out.close();
+                std::filesystem::remove(temporary);
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, nativePath, error);
+        if (error) {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+        return true;
+    }
+
+    static bool CompileFromHLSL(const ShaderSource& source, SDL_GPUShaderFormat format, ShaderBytecode& out) {
+        std::call_once(shadercrossInit, [] {
+            if (!SDL_ShaderCross_Init()) spdlog::error("Failed to initialize SDL_shadercross: {}", SDL_GetError());
+        });
+
+        SDL_ShaderCross_ShaderStage stage = source.stage == SDL_GPU_SHADERSTAGE_VERTEX ? SDL_SHADERCROSS_SHADERSTAGE_VERTEX : SDL_SHADERCROSS_SHADERSTAGE_FRAGMENT;
+
+        // null terminated, shadercross wants mutable strings
+        std::vector<std::string> defineStrings;
+        defineStrings.reserve(source.defines.size() * 2);
+        std::vector<SDL_ShaderCross_HLSL_Define> defines;
+        for (const auto& [name, value] : source.defines) {
+            char* defineName = defineStrings.emplace_back(name).data();
+            char* defineValue = defineStrings.emplace_back(value).data();
+            defines.push_back({ defineName, defineValue });
+        }
+        defines.push_back({ nullptr, nullptr });
+
+        SDL_ShaderCross_HLSL_Info hlslInfo = {};
+        hlslInfo.source = source.code.c_str();
+        hlslInfo.entrypoint = source.entrypoint.c_str();
+        hlslInfo.include_dir = source.includeDirectory.empty() ? nullptr : source.includeDirectory.c_str();
+        hlslInfo.defines = defines.data();
+        hlslInfo.shader_stage = stage;
+        hlslInfo.name = source.name.c_str();
+
+        size_t spirvSize = 0;
+        void* spirv = SDL_ShaderCross_CompileSPIRVFromHLSL(&hlslInfo, &spirvSize);
+        if (spirv == nullptr) {
+            spdlog::error("Failed to compile {}: {}", source.name, SDL_GetError());
+            return false;
+        }
+
+        SDL_ShaderCross_GraphicsShaderMetadata* metadata = SDL_ShaderCross_ReflectGraphicsSPIRV(static_cast<const Uint8*>(spirv), spirvSize, 0);
+        if (metadata == nullptr) {
+            spdlog::error("Failed to reflect {}: {}", source.name, SDL_GetError());
+            SDL_free(spirv);
+            return false;
+        }
+
+        out.stage = source.stage;
+        out.entrypoint = source.entrypoint;
+        out.samplers = metadata->resource_info.num_samplers;
+        out.storageTextures = metadata->resource_info.num_storage_textures;
+        out.storageBuffers = metadata->resource_info.num_storage_buffers;
+        out.uniformBuffers = metadata->resource_info.num_uniform_buffers;
+        SDL_free(metadata);
+
+        if (format == SDL_GPU_SHADERFORMAT_DXIL) {
+            SDL_ShaderCross_SPIRV_Info spirvInfo = {};
+            spirvInfo.bytecode = static_cast<const Uint8*>(spirv);
+            spirvInfo.bytecode_size = spirvSize;
+            spirvInfo.entrypoint = source.entrypoint.c_str();
+            spirvInfo.shader_stage = stage;
+            spirvInfo.name = source.name.c_str();
+
+            size_t dxilSize = 0;
+            void* dxil = SDL_ShaderCross_CompileDXILFromSPIRV(&spirvInfo, &dxilSize);
+            SDL_free(spirv);
+            if (dxil == nullptr) {
+                spdlog::error("Failed to compile {} to DXIL: {}", source.name, SDL_GetError());
+                return false;
+            }
+            out.format = SDL_GPU_SHADERFORMAT_DXIL;
+            out.code.assign(static_cast<const uint8_t*>(dxil), static_cast<const uint8_t*>(dxil) + dxilSize);
+            SDL_free(dxil);
+            return true;
+        }
+
+        out.format = SDL_GPU_SHADERFORMAT_SPIRV;
+        out.code.assign(static_cast<const uint8_t*>(spirv), static_cast<const uint8_t*>(spirv) + spirvSize);
+        SDL_free(spirv);
+        return true;
+    }
+
+    bool CompileShaderBytecode(const ShaderSource& source, ShaderBytecode& out) {
+        SDL_GPUShaderFormat format = GetTargetFormat();
+        uint64_t key = GetCacheKey(source, format);
+        std::string directory = GetShaderCacheDirectory();
+        std::string cachedPath = directory.empty() ? std::string() : fmt::format("{}{:016x}.shader", directory, key);
+
+        if (!cachedPath.empty() && ReadCachedShader(cachedPath, key, out)) {
+            spdlog::info("Loaded {} from the shader cache", source.name);
+            return true;
+        }
+
+        if (!CompileFromHLSL(source, format, out)) return false;
+
+        if (!cachedPath.empty()) {
+            std::error_code error;
+            std::filesystem::create_directories(directory, error);
+            if (!WriteCachedShader(cachedPath, key, out)) spdlog::warn("Failed to write cached shader {}", cachedPath);
+        }
+        return true;
+    }
+
+    SDL_GPUShader* CreateShader(const ShaderBytecode& bytecode) {
+        SDL_GPUShader* shader;
+        if (SDL_GetGPUShaderFormats(render::mainDevice) & bytecode.format) {
+            SDL_GPUShaderCreateInfo info = {};
+            info.code_size = bytecode.code.size();
+            info.code = bytecode.code.data();
+            info.entrypoint = bytecode.entrypoint.c_str();
+            info.format = bytecode.format;
+            info.stage = bytecode.stage;
+            info.num_samplers = bytecode.samplers;
+            info.num_storage_textures = bytecode.storageTextures;
+            info.num_storage_buffers = bytecode.storageBuffers;
+            info.num_uniform_buffers = bytecode.uniformBuffers;
+            shader = SDL_CreateGPUShader(render::mainDevice, &info);
+        } else {
+            // a backend that doesn't take spir-v directly, shadercross translates it
+            SDL_ShaderCross_SPIRV_Info spirvInfo = {};
+            spirvInfo.bytecode = bytecode.code.data();
+            spirvInfo.bytecode_size = bytecode.code.size();
+            spirvInfo.entrypoint = bytecode.entrypoint.c_str();
+            spirvInfo.shader_stage = bytecode.stage == SDL_GPU_SHADERSTAGE_VERTEX ? SDL_SHADERCROSS_SHADERSTAGE_VERTEX : SDL_SHADERCROSS_SHADERSTAGE_FRAGMENT;
+
+            SDL_ShaderCross_GraphicsShaderResourceInfo resources = {
+                bytecode.samplers, bytecode.storageTextures, bytecode.storageBuffers, bytecode.uniformBuffers
+            };
+            shader = SDL_ShaderCross_CompileGraphicsShaderFromSPIRV(render::mainDevice, &spirvInfo, &resources, 0);
+        }
+
+        if (shader == nullptr) spdlog::error("Failed to create shader {}: {}", bytecode.entrypoint, SDL_GetError());
+        return shader;
+    }
+
+    SDL_GPUShader* CompileShader(const ShaderSource& source) {
+        ShaderBytecode bytecode;
+        if (!CompileShaderBytecode(source, bytecode)) return nullptr;
+        return CreateShader(bytecode);
+    }
+
+    void SetShaderCacheDirectory(const std::string& nativePath) {
+        std::lock_guard lock(cacheMutex);
+        cacheDirectory = nativePath;
+    }
+
+    std::string GetShaderCacheDirectory() {
+        std::lock_guard lock(cacheMutex);
+        if (cacheDirectory.empty()) {
+            char* prefPath = SDL_GetPrefPath("MANIFOLD", "MANIFOLDEngineTest");
+            if (prefPath) {
+                cacheDirectory = std::string(prefPath) + "shadercache/";
+                SDL_free(prefPath);
+            }
+        }
+        return cacheDirectory;
+    }
+
+    void RegisterMaterialSources(const asset::Material* material, MaterialSources sources) {
+        std::lock_guard lock(registryMutex);
+        registry[material] = std::move(sources);
+    }
+
+    void UnregisterMaterialSources(const asset::Material* material) {
+        std::lock_guard lock(registryMutex);
+        registry.erase(material);
+        std::erase(reloaded, material);
+    }
+
+    bool GetMaterialSources(const asset::Material* material, MaterialSources& out) {
+        std::lock_guard lock(registryMutex);
+        auto found = registry.find(material);
+        if (found == registry.end()) return false;
+        out = found->second;
+        return true;
+    }
+
+    void ReplaceShaderSource(const ShaderSourcePtr& old, ShaderSourcePtr replacement) {
+        std::lock_guard lock(registryMutex);
+        for (auto& [material, sources] : registry) {
+            bool uses = false;
+            for (ShaderSourcePtr* source : { &sources.vertex, &sources.fragment }) {
+                if (*source != old) continue;
+                *source = replacement;
+                uses = true;
+            }
+            if (uses && std::find(reloaded.begin(), reloaded.end(), material) == reloaded.end()) reloaded.push_back(material);
+        }
+    }
+
+    void TakeReloadedMaterials(std::vector<const asset::Material*>& out) {
+        std::lock_guard lock(registryMutex);
+        out.insert(out.end(), reloaded.begin(), reloaded.end());
+        reloaded.clear();
+    }
+}
@@ -0,0 +1,82 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef SHADERCOMPILER_H
+#define SHADERCOMPILER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <SDL3/SDL.h>
+
+#include "asset/Material.h"
+
+namespace me::render {
+    // hlsl of one shader stage, as it was loaded
+    struct ShaderSource {
+        std::string name;
+        std::string code;
+        SDL_GPUShaderStage stage;
+        // our shaders name their entry point after the stage, "vertex" / "fragment"
+        std::string entrypoint;
+        // name, value
+        std::vector<std::pair<std::string, std::string>> defines;
+        // native directory #include is resolved against, the shader file's own. empty for sources not from a file
+        std::string includeDirectory;
+    };
+
+    typedef std::shared_ptr<const ShaderSource> ShaderSourcePtr;
+
+    // the shaders a material was made from
+    struct MaterialSources {
+        ShaderSourcePtr vertex;
+        ShaderSourcePtr fragment;
+    };
+
+    // a compiled stage, ready for SDL_CreateGPUShader
+    struct ShaderBytecode {
+        SDL_GPUShaderFormat format;
+        SDL_GPUShaderStage stage;
+        std::string entrypoint;
+        std::vector<uint8_t> code;
+        uint32_t samplers;
+        uint32_t storageTextures;
+        uint32_t storageBuffers;
+        uint32_t uniformBuffers;
+    };
+
+    // shader cache files are a header followed by the bytecode, named after the cache key
+    constexpr uint32_t SHADER_CACHE_MAGIC = 0x48535A4D;
+    // bump whenever the header or the compile steps change
+    constexpr uint32_t SHADER_CACHE_VERSION = 1;
+
+    // hlsl -> spir-v through SDL_shadercross, then dxil for d3d12. everything else keeps the spir-v,
+    // metal transpiles it when the shader is created. resource counts are reflected from the spir-v.
+    // results are cached on disk keyed by the source and everything it includes, entry point, stage, defines, format
+    // and shadercross version, so a warm start skips the hlsl compile. safe from any thread, false and logged on failure
+    bool CompileShaderBytecode(const ShaderSource& source, ShaderBytecode& out);
+    // null and logged on failure
+    SDL_GPUShader* CreateShader(const ShaderBytecode& bytecode);
+    // both of the above
+    SDL_GPUShader* CompileShader(const ShaderSource& source);
+
+    // native directory compiled shaders go to, defaults to a shadercache folder in SDL's pref path
+    void SetShaderCacheDirectory(const std::string& nativePath);
+    std::string GetShaderCacheDirectory();
+
+    // lets the renderer build pipelines for a material beyond the one the material makes itself.
+    // the registry is locked, the asset loader registers from its own threads
+    void RegisterMaterialSources(const asset::Material* material, MaterialSources sources);
+    void UnregisterMaterialSources(const asset::Material* material);
+    // false if the material wasn't registered
+    bool GetMaterialSources(const asset::Material* material, MaterialSources& out);
+    // swaps a reloaded source into every material that uses the old one, they're reported by TakeReloadedMaterials
+    void ReplaceShaderSource(const ShaderSourcePtr& old, ShaderSourcePtr replacement);
+    // moves the materials whose sources were replaced since the last call into out
+    void TakeReloadedMaterials(std::vector<const asset::Material*>& out);
+}
+
+#endif //SHADERCOMPILER_H
@@ -4,6 +4,16 @@
 
 #include "SimpleRenderPipeline.h"
 
+#include <algorithm>
+#include <optional>
+
+#include <spdlog/spdlog.h>
+
+#include "DrawKey.h"
+#include "RenderMath.h"
+#include "UploadRing.h"
+#include "../debug/Profiler.h"
+#include "../job/WorkerPool.h"
 #include "../imgui/imgui_impl_sdlgpu3.h"
 #include "render/RenderGlobals.h"
 #include "render/Window.h"
@@ -11,63 +21,410 @@
 #include "math/Transform.h"
 
 namespace me::render {
+    // default bytes of mesh data staged per frame
+    constexpr uint32_t MESH_UPLOAD_BUDGET = 8 * 1024 * 1024;
+    // elements per chunk for work split over job::mainWorkers
+    constexpr uint32_t PREPARE_GRAIN = 1024;
+    // starting geometry pool size in elements, it doubles when full
+    constexpr uint32_t POOL_VERTICES = 256 * 1024;
+    constexpr uint32_t POOL_INDICES = 1024 * 1024;
+
     struct WorldBuffer {
         math::PackedMatrix4x4 view;
         math::PackedMatrix4x4 proj;
     };
 
-    struct ObjectBuffer {
-        math::PackedMatrix4x4 model;
+    // index of the first instance of a batch, vertex.hlsl adds SV_InstanceID to it.
+    // the direct path leaves first_instance at 0 because SV_InstanceID doesn't include it on every backend,
+    // the indirect path pushes 0 here and relies on it instead
+    struct DrawBuffer {
+        uint32_t baseInstance;
+        uint32_t padding[3];
     };
 
-    SimpleRenderPipeline::SimpleRenderPipeline(asset::MaterialPtr material) {
+    SimpleRenderPipeline::SimpleRenderPipeline(asset::MaterialPtr material) : geometryPool(POOL_VERTICES, POOL_INDICES), uploadQueue(geometryPool, MESH_UPLOAD_BUDGET) {
         this->material = material;
-        material->CreateGPUPipeline();
-        pipeline = material->GetPipeline();
+        // starts building the fallback's pipeline now, it's needed on the first frame
+        pipelines.Get(material.get(), VertexFormat::Float3);
+        renderList.SetFallbackMaterial(material);
     }
 
-    void SimpleRenderPipeline::Render(scene::SceneWorld* world) {
-        auto list = world->GetSceneObjects();
-        std::vector<scene::SceneMesh*> meshes;
-        std::vector<asset::MeshTransfer> transfers;
-
-        for (scene::SceneObject* obj : list) {
-            scene::SceneMesh* meshObj = dynamic_cast<scene::SceneMesh*>(obj);
-            if (meshObj == nullptr) continue;
-            if (meshObj->mesh == nullptr) continue;
-
-            meshes.push_back(meshObj);
-            if (!meshObj->mesh->HasGPUBuffers()) {
-                meshObj->mesh->CreateGPUBuffers();
-                transfers.push_back(meshObj->mesh->StartTransfer());
+    SimpleRenderPipeline::~SimpleRenderPipeline() {
+        if (instanceBuffer) SDL_ReleaseGPUBuffer(render::mainDevice, instanceBuffer);
+        if (indirectBuffer) SDL_ReleaseGPUBuffer(render::mainDevice, indirectBuffer);
+    }
+
+    bool SimpleRenderPipeline::SupportsIndirect() {
+        return SDL_strcmp(SDL_GetGPUDeviceDriver(render::mainDevice), "direct3d12") != 0;
+    }
+
+    void SimpleRenderPipeline::SetRenderPath(RenderPath path) {
+        if (path == RenderPath::Indirect && !SupportsIndirect()) {
+            spdlog::warn("Indirect render path isn't supported on {}, staying on direct", SDL_GetGPUDeviceDriver(render::mainDevice));
+            path = RenderPath::Direct;
+        }
+        renderPath = path;
+    }
+
+    void SimpleRenderPipeline::ParallelFor(uint32_t count, const job::RangeTask& task) {
+        if (job::mainWorkers) {
+            job::mainWorkers->ParallelFor(count, PREPARE_GRAIN, task);
+        } else if (count > 0) {
+            task(0, count, 0);
+        }
+    }
+
+    void SimpleRenderPipeline::BuildBatches(const FrameSnapshot& frame) {
+        ME_PROFILE_SCOPE("Build Batches");
+        const auto& meshes = frame.meshes;
+        const auto& materials = frame.materials;
+        const auto& meshIds = frame.meshIds;
+        const auto& materialIds = frame.materialIds;
+        const auto& handles = frame.handles;
+
+        // every visible object picks its level here, the level is part of the key so it splits batches
+        sortKeys.resize(visible.size());
+        ParallelFor(static_cast<uint32_t>(visible.size()), [&](uint32_t begin, uint32_t end, uint32_t) {
+            for (uint32_t i = begin; i < end; i++) {
+                uint32_t index = visible[i];
+                float depth = culler.GetDepth(index);
+                uint32_t lod = lodSelector.Select(lodSelector.GetMeshLods(meshes[index]), culler.GetRadius(index), depth, lods[GetRenderHandleSlot(handles[index])]);
+                sortKeys[i] = MakeDrawKey(materialIds[index], meshFormats[meshIds[index]], meshIds[index], lod, depth);
+            }
+        });
+        RadixSort(sortKeys, visible, scratchKeys, scratchIndices);
+
+        instances.clear();
+        batches.clear();
+        stats.triangles = 0;
+        stats.fullTriangles = 0;
+        bool resident = false;
+        uint32_t fullIndexCount = 0;
+        for (size_t i = 0; i < visible.size(); i++) {
+            uint32_t index = visible[i];
+            if (i == 0 || DrawKeyState(sortKeys[i]) != DrawKeyState(sortKeys[i - 1])) {
+                // meshes still uploading are skipped, whole batches at a time
+                resident = uploadQueue.GetState(meshes[index]) == MeshUploadState::Resident;
+                if (resident) {
+                    const GeometryAllocation* range = geometryPool.Find(meshes[index]);
+                    const std::vector<MeshLod>& meshLods = lodSelector.GetMeshLods(meshes[index]);
+                    const MeshLod& lod = meshLods[DrawKeyLod(sortKeys[i])];
+                    fullIndexCount = meshLods[0].indexCount;
+                    batches.push_back({ meshes[index], materials[index], range->indexFormat, range->vertexFormat, lod.firstIndex, lod.indexCount,
+                                        static_cast<uint32_t>(instances.size()), 0 });
+                }
             }
+            if (!resident) continue;
+
+            batches.back().instanceCount++;
+            instances.push_back(index);
+            stats.triangles += batches.back().indexCount / 3;
+            stats.fullTriangles += fullIndexCount / 3;
         }
 
-        if (!transfers.empty()) {
-            SDL_GPUCommandBuffer* transferCmd = SDL_AcquireGPUCommandBuffer(render::mainDevice);
-            SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(transferCmd);
+        stats.instances = static_cast<uint32_t>(instances.size());
+    }
+
+    void* SimpleRenderPipeline::StageBuffer(uint32_t size, SDL_GPUBuffer*& buffer, uint32_t& capacity,
+                                            SDL_GPUBufferUsageFlags usage, const char* name) {
+        if (size > capacity) {
+            if (buffer) SDL_ReleaseGPUBuffer(render::mainDevice, buffer);
+
+            capacity = std::max(size, capacity * 2);
+
+            SDL_GPUBufferCreateInfo bufferInfo = {
+                .usage = usage,
+                .size = capacity
+            };
+            buffer = SDL_CreateGPUBuffer(render::mainDevice, &bufferInfo);
+            SDL_SetGPUBufferName(render::mainDevice, buffer, name);
+        }
 
-            for (asset::MeshTransfer& transfer : transfers) {
-                for (asset::MeshTransferSection& section : transfer.sections) {
-                    SDL_UploadToGPUBuffer(copyPass, &section.location, &section.region, false);
+        UploadAllocation allocation;
+        if (!mainUploadRing->Allocate(size, 16, allocation, true)) {
+            spdlog::error("Upload ring can't fit {} bytes for {}", size, name);
+            return nullptr;
+        }
+
+        // the upload is flagged to cycle, last frame's draws can still be reading the buffer
+        uploads.push_back({ allocation.location, { buffer, 0, size } });
+        firstCycledUpload = std::min(firstCycledUpload, static_cast<uint32_t>(uploads.size() - 1));
+        return allocation.data;
+    }
+
+    void SimpleRenderPipeline::StageInstances(const FrameSnapshot& frame) {
+        ME_PROFILE_SCOPE("Stage Instances");
+        if (instances.empty()) return;
+
+        uint32_t size = static_cast<uint32_t>(instances.size() * sizeof(math::PackedMatrix4x4));
+        auto* data = static_cast<math::PackedMatrix4x4*>(StageBuffer(size, instanceBuffer, instanceCapacity, SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ, "InstanceBuffer"));
+        if (data == nullptr) {
+            batches.clear();
+            return;
+        }
+
+        // matrices are packed straight into the ring, each chunk owns its own slice of the allocation.
+        // quantized meshes get their bounds folded in, so the shader reads unorm positions as they are
+        const auto& models = frame.models;
+        ParallelFor(static_cast<uint32_t>(instances.size()), [&](uint32_t begin, uint32_t end, uint32_t) {
+            auto batch = std::upper_bound(batches.begin(), batches.end(), begin,
+                                          [](uint32_t instance, const DrawBatch& b) { return instance < b.firstInstance; }) - 1;
+            for (uint32_t i = begin; i < end; i++) {
+                while (i >= batch->firstInstance + batch->instanceCount) ++batch;
+                if (batch->vertexFormat == VertexFormat::UNorm16) {
+                    const AABB& bounds = culler.GetMeshBounds(batch->mesh);
+                    DequantizeMatrix(reinterpret_cast<const float*>(&models[instances[i]]), bounds.min, bounds.max, reinterpret_cast<float*>(&data[i]));
+                } else {
+                    data[i] = models[instances[i]];
                 }
             }
-            SDL_EndGPUCopyPass(copyPass);
+        });
+    }
+
+    void SimpleRenderPipeline::StageIndirectCommands() {
+        indirectCommands.clear();
+        if (renderPath != RenderPath::Indirect || batches.empty()) return;
+
+        // first_instance reaches the shader through SV_InstanceID, so objects are found without a uniform per draw
+        for (const DrawBatch& batch : batches) {
+            const GeometryAllocation* range = geometryPool.Find(batch.mesh);
+            indirectCommands.push_back({
+                batch.indexCount,
+                batch.instanceCount,
+                range->indexOffset + batch.firstIndex,
+                static_cast<int32_t>(range->vertexOffset),
+                batch.firstInstance
+            });
+        }
+
+        uint32_t size = static_cast<uint32_t>(indirectCommands.size() * sizeof(SDL_GPUIndexedIndirectDrawCommand));
+        void* data = StageBuffer(size, indirectBuffer, indirectCapacity, SDL_GPU_BUFFERUSAGE_INDIRECT, "IndirectBuffer");
+        if (data == nullptr) {
+            batches.clear();
+            return;
+        }
+        memcpy(data, indirectCommands.data(), size);
+    }
+
+    void SimpleRenderPipeline::RecordUploads(SDL_GPUCommandBuffer* commandBuffer) {
+        if (uploads.empty()) return;
+
+        mainUploadRing->Unmap();
+        SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+        for (uint32_t i = 0; i < uploads.size(); i++) {
+            SDL_UploadToGPUBuffer(copyPass, &uploads[i].location, &uploads[i].region, i >= firstCycledUpload);
+        }
+        SDL_EndGPUCopyPass(copyPass);
+
+        uploads.clear();
+        firstCycledUpload = UINT32_MAX;
+    }
+
+    void SimpleRenderPipeline::BindVertexBuffer(SDL_GPURenderPass* renderPass, VertexFormat format, std::optional<VertexFormat>& bound) {
+        if (bound == format) {
+            stats.bindsSkipped++;
+            return;
+        }
+
+        bound = format;
+        SDL_GPUBufferBinding vertexBinding = { geometryPool.GetVertexBuffer(format), 0 };
+        SDL_BindGPUVertexBuffers(renderPass, 0, &vertexBinding, 1);
+        stats.bindsIssued++;
+    }
+
+    void SimpleRenderPipeline::BindIndexBuffer(SDL_GPURenderPass* renderPass, IndexFormat format, std::optional<IndexFormat>& bound) {
+        if (bound == format) {
+            stats.bindsSkipped++;
+            return;
+        }
+
+        bound = format;
+        SDL_GPUBufferBinding indexBinding = { geometryPool.GetIndexBuffer(format), 0 };
+        SDL_BindGPUIndexBuffer(renderPass, &indexBinding, format == IndexFormat::UInt32 ? SDL_GPU_INDEXELEMENTSIZE_32BIT : SDL_GPU_INDEXELEMENTSIZE_16BIT);
+        stats.bindsIssued++;
+    }
+
+    void SimpleRenderPipeline::DrawDirect(SDL_GPUCommandBuffer* commandBuffer, SDL_GPURenderPass* renderPass) {
+        ME_PROFILE_SCOPE("Record Draws");
+        SDL_GPUGraphicsPipeline* boundPipeline = nullptr;
+        std::optional<VertexFormat> boundVertexFormat;
+        std::optional<IndexFormat> boundIndexFormat;
+
+        for (const DrawBatch& batch : batches) {
+            SDL_GPUGraphicsPipeline* pipeline = pipelines.Get(batch.material, batch.vertexFormat);
+            if (pipeline == nullptr) continue;
+
+            if (pipeline != boundPipeline) {
+                boundPipeline = pipeline;
+                SDL_BindGPUGraphicsPipeline(renderPass, boundPipeline);
+                stats.bindsIssued++;
+            } else {
+                stats.bindsSkipped++;
+            }
 
-            for (asset::MeshTransfer& transfer : transfers) {
-                // releasing before submitting looks wrong but it does it during a submit
-                SDL_ReleaseGPUTransferBuffer(render::mainDevice, transfer.buffer);
+            BindVertexBuffer(renderPass, batch.vertexFormat, boundVertexFormat);
+            BindIndexBuffer(renderPass, batch.indexFormat, boundIndexFormat);
+
+            const GeometryAllocation* range = geometryPool.Find(batch.mesh);
+            DrawBuffer drawBuffer = { batch.firstInstance };
+            SDL_PushGPUVertexUniformData(commandBuffer, 1, &drawBuffer, sizeof(DrawBuffer));
+            SDL_DrawGPUIndexedPrimitives(renderPass, batch.indexCount, batch.instanceCount, range->indexOffset + batch.firstIndex,
+                                         static_cast<int32_t>(range->vertexOffset), 0);
+            stats.drawCalls++;
+        }
+        stats.indirectCommands = 0;
+    }
+
+    void SimpleRenderPipeline::DrawIndirect(SDL_GPUCommandBuffer* commandBuffer, SDL_GPURenderPass* renderPass) {
+        ME_PROFILE_SCOPE("Record Draws");
+        // first_instance already points at the batch's objects
+        DrawBuffer drawBuffer = { 0 };
+        SDL_PushGPUVertexUniformData(commandBuffer, 1, &drawBuffer, sizeof(DrawBuffer));
+
+        // batches are sorted by material, vertex format and index format first,
+        // so everything drawn with the same pipeline and buffers is one contiguous run of commands
+        SDL_GPUGraphicsPipeline* boundPipeline = nullptr;
+        std::optional<VertexFormat> boundVertexFormat;
+        std::optional<IndexFormat> boundIndexFormat;
+        size_t first = 0;
+        while (first < batches.size()) {
+            asset::Material* material = batches[first].material;
+            VertexFormat vertexFormat = batches[first].vertexFormat;
+            IndexFormat indexFormat = batches[first].indexFormat;
+            size_t last = first + 1;
+            while (last < batches.size() && batches[last].material == material && batches[last].vertexFormat == vertexFormat
+                   && batches[last].indexFormat == indexFormat) {
+                last++;
+            }
+
+            SDL_GPUGraphicsPipeline* pipeline = pipelines.Get(material, vertexFormat);
+            if (pipeline == nullptr) {
+                first = last;
+                continue;
+            }
+            if (pipeline != boundPipeline) {
+                boundPipeline = pipeline;
+                SDL_BindGPUGraphicsPipeline(renderPass, boundPipeline);
+                stats.bindsIssued++;
+            } else {
+                stats.bindsSkipped++;
             }
+            BindVertexBuffer(renderPass, vertexFormat, boundVertexFormat);
+            BindIndexBuffer(renderPass, indexFormat, boundIndexFormat);
 
-            SDL_SubmitGPUCommandBuffer(transferCmd);
+            uint32_t offset = static_cast<uint32_t>(first * sizeof(SDL_GPUIndexedIndirectDrawCommand));
+            SDL_DrawGPUIndexedPrimitivesIndirect(renderPass, indirectBuffer, offset, static_cast<uint32_t>(last - first));
+            stats.drawCalls++;
+            first = last;
         }
+        stats.indirectCommands = static_cast<uint32_t>(indirectCommands.size());
+    }
+
+    void SimpleRenderPipeline::Render(scene::SceneWorld* world) {
+        Capture(world, immediate);
+        Render(immediate);
+    }
+
+    void SimpleRenderPipeline::Capture(scene::SceneWorld* world, FrameSnapshot& out) {
+        ME_PROFILE_SCOPE("Render Capture");
+        uint64_t captureStart = SDL_GetTicksNS();
+        renderList.Update(job::mainWorkers);
+
+        out.frame = capturedFrames++;
+        world->GetCamera().GetTransform().Raw().ToSRT(true).StoreFloat4x4(out.view);
+        world->GetCamera().GetProjectionMatrix().StoreFloat4x4(out.proj);
+        out.fov = world->GetCamera().GetFOV();
+
+        // assign keeps the snapshot's capacity, after the first few frames this doesn't allocate
+        out.meshes.assign(renderList.GetMeshes().begin(), renderList.GetMeshes().end());
+        out.materials.assign(renderList.GetMaterials().begin(), renderList.GetMaterials().end());
+        out.meshIds.assign(renderList.GetMeshIds().begin(), renderList.GetMeshIds().end());
+        out.materialIds.assign(renderList.GetMaterialIds().begin(), renderList.GetMaterialIds().end());
+        out.models.assign(renderList.GetModels().begin(), renderList.GetModels().end());
+        out.handles.assign(renderList.GetHandles().begin(), renderList.GetHandles().end());
+        out.handleCount = renderList.GetHandleCount();
+        out.changed.assign(renderList.GetChanged().begin(), renderList.GetChanged().end());
+
+        renderList.TakeRemovedMeshes(out.removedMeshes);
+        renderList.TakeNewMeshes(out.newMeshes);
+        out.newMeshIds.clear();
+        for (asset::Mesh* mesh : out.newMeshes) out.newMeshIds.push_back(renderList.GetMeshId(mesh));
+
+        out.captureTicks = SDL_GetTicksNS();
+        out.captureNanoseconds = out.captureTicks - captureStart;
+    }
+
+    void SimpleRenderPipeline::Render(const FrameSnapshot& frame) {
+        ME_PROFILE_SCOPE("SimpleRenderPipeline::Render");
+        mainUploadRing->Retire();
+        pipelines.Update();
+        stats.captureNanoseconds = frame.captureNanoseconds;
+
+        // before any range is handed out or staged this frame, so every upload targets the final buffers
+        if (defragmentRequested || geometryPool.NeedsDefragment()) {
+            if (!geometryPool.HasPendingRelocations()) {
+                geometryPool.Defragment();
+                defragmentRequested = false;
+            }
+        }
+
+        // removals first, the same mesh can be removed and added again within a step
+        for (const asset::MeshPtr& removed : frame.removedMeshes) {
+            asset::Mesh* mesh = removed.get();
+            uploadQueue.Forget(mesh);
+            culler.ForgetMesh(mesh);
+            lodSelector.ForgetMesh(mesh);
+        }
+        for (size_t i = 0; i < frame.newMeshes.size(); i++) {
+            asset::Mesh* mesh = frame.newMeshes[i];
+            culler.GetMeshBounds(mesh);
+            lodSelector.GetMeshLods(mesh);
+            uint32_t meshId = frame.newMeshIds[i];
+            if (meshId >= meshFormats.size()) meshFormats.resize(meshId + 1, 0);
+            MeshGeometryPtr geometry = GetMeshGeometry(mesh);
+            meshFormats[meshId] = static_cast<uint32_t>(geometry->vertexFormat) | static_cast<uint32_t>(geometry->indexFormat) << 1;
+            if (!uploadQueue.Enqueue(mesh)) {
+                spdlog::error("Geometry pool has no room for a mesh with {} vertices", geometry->vertexCount);
+            }
+        }
+        uploadQueue.Process(uploads);
+        if (lods.size() < frame.handleCount) lods.resize(frame.handleCount, NO_LOD);
+
+        WorldBuffer worldBuffer = { frame.view, frame.proj };
+
+        uint64_t prepareStart = SDL_GetTicksNS();
+        culler.SetViewProjection(reinterpret_cast<const float*>(&worldBuffer.view), reinterpret_cast<const float*>(&worldBuffer.proj));
+        culler.Resize(static_cast<uint32_t>(frame.meshes.size()));
+
+        // every mesh here went through the new meshes above, so the bounds lookups don't insert
+        const auto& changed = frame.changed;
+        ParallelFor(static_cast<uint32_t>(changed.size()), [&](uint32_t begin, uint32_t end, uint32_t) {
+            for (uint32_t i = begin; i < end; i++) {
+                uint32_t index = changed[i];
+                const AABB& bounds = culler.GetMeshBounds(frame.meshes[index]);
+                culler.Set(index, bounds, reinterpret_cast<const float*>(&frame.models[index]));
+            }
+        });
+        culler.Cull(visible, job::mainWorkers);
+
+        int viewportWidth = 0, viewportHeight = 0;
+        SDL_GetWindowSizeInPixels(render::mainWindow->GetWindow(), &viewportWidth, &viewportHeight);
+        lodSelector.SetView(frame.fov, static_cast<float>(viewportHeight));
+        BuildBatches(frame);
+        StageInstances(frame);
+        StageIndirectCommands();
+        stats.prepareNanoseconds = SDL_GetTicksNS() - prepareStart;
 
         SDL_GPUCommandBuffer* commandBuffer = SDL_AcquireGPUCommandBuffer(render::mainDevice);
-        SDL_GPUTexture* swapchainTex;
-        if (!SDL_AcquireGPUSwapchainTexture(commandBuffer, render::mainWindow->GetWindow(), &swapchainTex, NULL, NULL)) {
+        geometryPool.RecordRelocations(commandBuffer);
+        RecordUploads(commandBuffer);
+
+        SDL_GPUTexture* swapchainTex = nullptr;
+        if (!SDL_AcquireGPUSwapchainTexture(commandBuffer, render::mainWindow->GetWindow(), &swapchainTex, NULL, NULL) || swapchainTex == nullptr) {
+            // still submit, the copies above already own their ring space
+            mainUploadRing->Submit(commandBuffer);
             return;
         }
-        if (swapchainTex == nullptr) return;
 
         const SDL_GPUColorTargetInfo colorTargetInfo = {
             .texture = swapchainTex,
@@ -77,27 +434,24 @@ namespace me::render {
         };
 
         SDL_GPURenderPass* renderPass = SDL_BeginGPURenderPass(commandBuffer, &colorTargetInfo, 1, NULL);
-        SDL_BindGPUGraphicsPipeline(renderPass, material->GetPipeline());
-
-        WorldBuffer worldBuffer;
-        world->GetCamera().GetTransform().Raw().ToSRT(true).StoreFloat4x4(worldBuffer.view);
-        world->GetCamera().GetProjectionMatrix().StoreFloat4x4(worldBuffer.proj);
         SDL_PushGPUVertexUniformData(commandBuffer, 0, &worldBuffer, sizeof(WorldBuffer));
+        stats.bindsIssued = 0;
+        stats.bindsSkipped = 0;
+        if (!batches.empty()) {
+            SDL_BindGPUVertexStorageBuffers(renderPass, 0, &instanceBuffer, 1);
+        }
 
-        for (scene::SceneMesh* mesh : meshes) {
-            ObjectBuffer objectBuffer;
-            mesh->GetTransform().Raw().ToTRS(true).StoreFloat4x4(objectBuffer.model);
-
-            SDL_GPUBufferBinding vertexBinding = { mesh->mesh->GetGPUVertexBuffer(), 0 };
-            SDL_GPUBufferBinding indexBinding = { mesh->mesh->GetGPUIndexBuffer(), 0 };
-            SDL_BindGPUVertexBuffers(renderPass, 0, &vertexBinding, 1);
-            SDL_BindGPUIndexBuffer(renderPass, &indexBinding, SDL_GPU_INDEXELEMENTSIZE_16BIT);
-            SDL_PushGPUVertexUniformData(commandBuffer, 1, &objectBuffer, sizeof(ObjectBuffer));
-            SDL_DrawGPUIndexedPrimitives(renderPass, mesh->mesh->GetIndexBuffer().size(), 1, 0, 0, 0);
+        uint64_t recordStart = SDL_GetTicksNS();
+        stats.drawCalls = 0;
+        if (renderPath == RenderPath::Indirect) {
+            DrawIndirect(commandBuffer, renderPass);
+        } else {
+            DrawDirect(commandBuffer, renderPass);
         }
+        stats.recordNanoseconds = SDL_GetTicksNS() - recordStart;
         SDL_EndGPURenderPass(renderPass);
 
         ImGui_ImplSDLGPU3_RenderDrawData(ImGui::GetDrawData(), commandBuffer, swapchainTex);
-        SDL_SubmitGPUCommandBuffer(commandBuffer);
+        mainUploadRing->Submit(commandBuffer);
     }
 }
@@ -5,19 +5,140 @@
 #ifndef SIMPLERENDERPIPELINE_H
 #define SIMPLERENDERPIPELINE_H
 
+#include <optional>
+
 #include "render/RenderPipeline.h"
 #include "asset/Material.h"
+#include "FrameSnapshot.h"
+#include "FrustumCuller.h"
+#include "GeometryPool.h"
+#include "LodSelector.h"
+#include "MaterialPipelines.h"
+#include "MeshUploadQueue.h"
+#include "RenderList.h"
 
 namespace me::render {
+    struct RenderStats {
+        // draw calls issued to the api, one per pipeline change on the indirect path
+        uint32_t drawCalls;
+        uint32_t indirectCommands;
+        uint32_t instances;
+        uint32_t bindsIssued;
+        uint32_t bindsSkipped;
+        // triangles drawn, and what they'd have been with every object at its full level
+        uint64_t triangles;
+        uint64_t fullTriangles;
+        // cpu time for the render list update and the copy into the snapshot, for the frame drawn last
+        uint64_t captureNanoseconds;
+        // cpu time from culling to the last staged byte
+        uint64_t prepareNanoseconds;
+        uint64_t recordNanoseconds;
+    };
+
+    enum class RenderPath {
+        // one SDL_DrawGPUIndexedPrimitives per batch
+        Direct,
+        // batches written to a buffer as indirect commands, one SDL_DrawGPUIndexedPrimitivesIndirect per pipeline
+        Indirect
+    };
+
     class SimpleRenderPipeline : public RenderPipeline {
         private:
+        // every visible object sharing a mesh, level of detail and material, drawn with one instanced call.
+        // instances inside a batch are in front to back order
+        struct DrawBatch {
+            asset::Mesh* mesh;
+            asset::Material* material;
+            IndexFormat indexFormat;
+            VertexFormat vertexFormat;
+            // the level's indices, relative to the mesh's range in the pool
+            uint32_t firstIndex;
+            uint32_t indexCount;
+            uint32_t firstInstance;
+            uint32_t instanceCount;
+        };
+
         asset::MaterialPtr material;
-        SDL_GPUGraphicsPipeline* pipeline;
+
+        RenderList renderList;
+        FrustumCuller culler;
+        LodSelector lodSelector;
+        MaterialPipelines pipelines;
+        // draw key format bits of every mesh, vertex and index format, indexed by render list mesh id
+        std::vector<uint32_t> meshFormats;
+        // level of detail each object was drawn with last, indexed by render handle slot so it follows the object when it moves
+        std::vector<uint8_t> lods;
+        // for Render(SceneWorld*), which captures and draws in one go
+        FrameSnapshot immediate = {};
+        uint64_t capturedFrames = 0;
+        std::vector<uint32_t> visible;
+
+        GeometryPool geometryPool;
+        MeshUploadQueue uploadQueue;
+        bool defragmentRequested = false;
+        std::vector<asset::MeshTransferSection> uploads;
+        // uploads from here on go to buffers the last frame may still read, they cycle
+        uint32_t firstCycledUpload = UINT32_MAX;
+
+        std::vector<uint64_t> sortKeys;
+        std::vector<uint64_t> scratchKeys;
+        std::vector<uint32_t> scratchIndices;
+        std::vector<DrawBatch> batches;
+        // dense index of every drawn object, in batch order
+        std::vector<uint32_t> instances;
+        SDL_GPUBuffer* instanceBuffer = nullptr;
+        uint32_t instanceCapacity = 0;
+
+        RenderPath renderPath = RenderPath::Direct;
+        std::vector<SDL_GPUIndexedIndirectDrawCommand> indirectCommands;
+        SDL_GPUBuffer* indirectBuffer = nullptr;
+        uint32_t indirectCapacity = 0;
+
+        RenderStats stats = {};
+
+        // splits work over job::mainWorkers, or runs it inline without them
+        void ParallelFor(uint32_t count, const job::RangeTask& task);
+        void BuildBatches(const FrameSnapshot& frame);
+        // copies go through mainUploadRing and are recorded in one copy pass at the start of the frame
+        // returns where to write size bytes for buffer, or nullptr if the ring is full
+        void* StageBuffer(uint32_t size, SDL_GPUBuffer*& buffer, uint32_t& capacity,
+                          SDL_GPUBufferUsageFlags usage, const char* name);
+        void StageInstances(const FrameSnapshot& frame);
+        void StageIndirectCommands();
+        void RecordUploads(SDL_GPUCommandBuffer* commandBuffer);
+        void BindVertexBuffer(SDL_GPURenderPass* renderPass, VertexFormat format, std::optional<VertexFormat>& bound);
+        void BindIndexBuffer(SDL_GPURenderPass* renderPass, IndexFormat format, std::optional<IndexFormat>& bound);
+        void DrawDirect(SDL_GPUCommandBuffer* commandBuffer, SDL_GPURenderPass* renderPass);
+        void DrawIndirect(SDL_GPUCommandBuffer* commandBuffer, SDL_GPURenderPass* renderPass);
 
         public:
         SimpleRenderPipeline(asset::MaterialPtr material);
+        ~SimpleRenderPipeline();
 
+        // Capture then Render on the calling thread
         void Render(scene::SceneWorld* world) override;
+        // copies what the renderer needs out of the render list and the camera, on the thread that owns the scene.
+        // the render list isn't touched again until the next capture
+        void Capture(scene::SceneWorld* world, FrameSnapshot& out);
+        // draws a captured frame, on the thread that owns the window. frames have to come in the order they were captured
+        void Render(const FrameSnapshot& frame);
+
+        // scene meshes have to be registered here to be drawn
+        RenderList& GetRenderList() { return renderList; }
+
+        const CullStats& GetCullStats() const { return culler.GetStats(); }
+        LodSelector& GetLodSelector() { return lodSelector; }
+        const RenderStats& GetStats() const { return stats; }
+        MeshUploadQueue& GetUploadQueue() { return uploadQueue; }
+        const MaterialPipelines& GetPipelines() const { return pipelines; }
+
+        // d3d12 leaves first_instance out of SV_InstanceID, there the indirect path can't find its objects
+        static bool SupportsIndirect();
+        void SetRenderPath(RenderPath path);
+        RenderPath GetRenderPath() const { return renderPath; }
+        const GeometryPool& GetGeometryPool() const { return geometryPool; }
+        // the pool also defragments by itself once free space gets too scattered
+        void RequestDefragment() { defragmentRequested = true; }
     };
 }
 
@@ -0,0 +1,109 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "UploadRing.h"
+
+#include <spdlog/spdlog.h>
+
+#include "../debug/Profiler.h"
+
+namespace me::render {
+    UploadRing* mainUploadRing = nullptr;
+
+    UploadRing::UploadRing(SDL_GPUDevice* device, uint32_t capacity) {
+        this->device = device;
+        this->capacity = capacity;
+
+        SDL_GPUTransferBufferCreateInfo info = {
+            .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+            .size = capacity
+        };
+        buffer = SDL_CreateGPUTransferBuffer(device, &info);
+        if (buffer == nullptr) {
+            spdlog::error("Failed to create upload ring: {}", SDL_GetError());
+            this->capacity = 0;
+        }
+    }
+
+    UploadRing::~UploadRing() {
+        Unmap();
+        for (Frame& frame : inFlight) {
+            SDL_WaitForGPUFences(device, true, &frame.fence, 1);
+            SDL_ReleaseGPUFence(device, frame.fence);
+        }
+        if (buffer) SDL_ReleaseGPUTransferBuffer(device, buffer);
+    }
+
+    bool UploadRing::Allocate(uint32_t size, uint32_t alignment, UploadAllocation& out, bool wait) {
+        if (size == 0 || size > capacity) return false;
+
+        while (true) {
+            uint32_t offset = (head + alignment - 1) / alignment * alignment;
+            uint32_t needed = offset - head + size;
+            if (offset + size > capacity) {
+                // doesn't fit before the end, skip the rest of the buffer and start over at zero
+                offset = 0;
+                needed = capacity - head + size;
+            }
+
+            if (used + needed <= capacity) {
+                if (mapped == nullptr) {
+                    mapped = static_cast<uint8_t*>(SDL_MapGPUTransferBuffer(device, buffer, false));
+                    if (mapped == nullptr) return false;
+                }
+
+                head = offset + size;
+                if (head == capacity) head = 0;
+                used += needed;
+                frameBytes += needed;
+
+                out.location = { buffer, offset };
+                out.data = mapped + offset;
+                out.size = size;
+                return true;
+            }
+
+            Retire();
+            if (used + needed <= capacity) continue;
+            if (!wait || inFlight.empty()) return false;
+
+            SDL_WaitForGPUFences(device, true, &inFlight.front().fence, 1);
+            Retire();
+        }
+    }
+
+    void UploadRing::Unmap() {
+        if (mapped == nullptr) return;
+        SDL_UnmapGPUTransferBuffer(device, buffer);
+        mapped = nullptr;
+    }
+
+    bool UploadRing::Submit(SDL_GPUCommandBuffer* commandBuffer) {
+        Unmap();
+
+        SDL_GPUFence* fence = SDL_SubmitGPUCommandBufferAndAcquireFence(commandBuffer);
+        if (fence == nullptr) {
+            spdlog::error("Failed to submit command buffer: {}", SDL_GetError());
+            // nothing will signal, keep the bytes charged to the next frame instead of leaking them
+            return false;
+        }
+
+        inFlight.push_back({ fence, frameBytes, SDL_GetTicksNS() });
+        frameBytes = 0;
+        submittedFrames++;
+        Retire();
+        return true;
+    }
+
+    void UploadRing::Retire() {
+        while (!inFlight.empty() && SDL_QueryGPUFence(device, inFlight.front().fence)) {
+            debug::mainProfiler.AddGpuZone("GPU Frame", inFlight.front().submitTicks, SDL_GetTicksNS());
+            used -= inFlight.front().bytes;
+            SDL_ReleaseGPUFence(device, inFlight.front().fence);
+            inFlight.pop_front();
+            completedFrames++;
+        }
+        if (used == 0) head = 0;
+    }
+}
@@ -0,0 +1,69 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef UPLOADRING_H
+#define UPLOADRING_H
+
+#include <cstdint>
+#include <deque>
+#include <SDL3/SDL.h>
+
+namespace me::render {
+    struct UploadAllocation {
+        SDL_GPUTransferBufferLocation location;
+        void* data;
+        uint32_t size;
+    };
+
+    // one persistently reused upload transfer buffer handed out as a ring.
+    // everything allocated between two Submit calls belongs to that frame, and its bytes come back once the frame's fence signals.
+    // allocations are written through the mapped pointer, call Unmap before recording a copy pass that reads them.
+    class UploadRing {
+        private:
+        struct Frame {
+            SDL_GPUFence* fence;
+            uint32_t bytes;
+            uint64_t submitTicks;
+        };
+
+        SDL_GPUDevice* device;
+        SDL_GPUTransferBuffer* buffer;
+        uint32_t capacity;
+
+        uint32_t head = 0;
+        uint32_t used = 0;
+        uint32_t frameBytes = 0;
+        uint8_t* mapped = nullptr;
+        std::deque<Frame> inFlight;
+        uint64_t submittedFrames = 0;
+        uint64_t completedFrames = 0;
+
+        public:
+        UploadRing(SDL_GPUDevice* device, uint32_t capacity);
+        ~UploadRing();
+
+        // returns false if the ring can't fit the allocation right now.
+        // with wait set, blocks on older frames until it fits, it only fails if this frame alone fills the ring
+        bool Allocate(uint32_t size, uint32_t alignment, UploadAllocation& out, bool wait = false);
+        void Unmap();
+
+        // submits the command buffer and fences everything allocated since the last submit
+        bool Submit(SDL_GPUCommandBuffer* commandBuffer);
+        // gives back space from frames the gpu is done with.
+        // each one shows up in the profiler as a gpu span from its submit to the first Retire that saw its fence signaled
+        void Retire();
+
+        // frame serials, allocations made now land in frame GetSubmittedFrames() + 1
+        uint64_t GetSubmittedFrames() const { return submittedFrames; }
+        uint64_t GetCompletedFrames() const { return completedFrames; }
+
+        uint32_t GetCapacity() const { return capacity; }
+        uint32_t GetUsed() const { return used; }
+        uint32_t GetFramesInFlight() const { return static_cast<uint32_t>(inFlight.size()); }
+    };
+
+    extern UploadRing* mainUploadRing;
+}
+
+#endif //UPLOADRING_H
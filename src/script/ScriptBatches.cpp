@@ -0,0 +1,74 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "ScriptBatches.h"
+
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+
+#include "../debug/Profiler.h"
+
+namespace me::script {
+    ScriptBatches mainBatches;
+
+    void ScriptBatches::Add(std::vector<std::unique_ptr<Batch>>& list, const std::string& name, vclosure* update) {
+        for (auto& batch : list) {
+            if (batch->name != name) continue;
+            batch->update = update;
+            return;
+        }
+
+        auto batch = std::make_unique<Batch>(Batch { name, debug::mainProfiler.InternName(name), update });
+        hl_add_root(&batch->update);
+        list.push_back(std::move(batch));
+    }
+
+    bool ScriptBatches::Call(const Batch& batch) {
+        ME_PROFILE_SCOPE(batch.profileName);
+        bool isException = false;
+        hl_dyn_call_safe(batch.update, nullptr, 0, &isException);
+        if (isException) {
+            spdlog::error("Script {} threw", batch.name);
+        }
+        return !isException;
+    }
+
+    void ScriptBatches::Register(const std::string& name, vclosure* update) {
+        Add(batches, name, update);
+    }
+
+    void ScriptBatches::RegisterCommand(const std::string& name, vclosure* command) {
+        Add(commands, name, command);
+    }
+
+    void ScriptBatches::Clear() {
+        for (auto& batch : batches) {
+            hl_remove_root(&batch->update);
+        }
+        for (auto& command : commands) {
+            hl_remove_root(&command->update);
+        }
+        batches.clear();
+        commands.clear();
+    }
+
+    void ScriptBatches::Dispatch() {
+        ME_PROFILE_SCOPE("Script Batches");
+        uint64_t start = SDL_GetTicksNS();
+        uint32_t failed = 0;
+
+        for (auto& batch : batches) {
+            if (!Call(*batch)) failed++;
+        }
+
+        stats.batches = static_cast<uint32_t>(batches.size());
+        stats.failed = failed;
+        stats.dispatchNanoseconds = SDL_GetTicksNS() - start;
+    }
+
+    bool ScriptBatches::RunCommand(uint32_t index) {
+        if (index >= commands.size()) return false;
+        return Call(*commands[index]);
+    }
+}
@@ -0,0 +1,62 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef SCRIPTBATCHES_H
+#define SCRIPTBATCHES_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <hl.h>
+
+namespace me::script {
+    struct ScriptBatchStats {
+        uint32_t batches;
+        // batches that threw during the last Dispatch
+        uint32_t failed;
+        uint64_t dispatchNanoseconds;
+    };
+
+    // update functions registered by script component types, each one runs every component of its type.
+    // a frame enters the VM once per type instead of once per component.
+    // scripts can also register commands, which only run when asked to, like benchmarks behind a debug button.
+    // everything here runs on the thread the VM was started on
+    class ScriptBatches {
+        private:
+        struct Batch {
+            std::string name;
+            // interned, zones keep it after the batch is cleared
+            const char* profileName;
+            // a gc root, so it lives at a fixed address
+            vclosure* update;
+        };
+
+        std::vector<std::unique_ptr<Batch>> batches;
+        std::vector<std::unique_ptr<Batch>> commands;
+        ScriptBatchStats stats = {};
+
+        static void Add(std::vector<std::unique_ptr<Batch>>& list, const std::string& name, vclosure* update);
+        // false if it threw
+        static bool Call(const Batch& batch);
+
+        public:
+        // a second register under the same name replaces the first, for when the code is reloaded
+        void Register(const std::string& name, vclosure* update);
+        void RegisterCommand(const std::string& name, vclosure* command);
+        void Clear();
+
+        void Dispatch();
+
+        uint32_t GetCommandCount() const { return static_cast<uint32_t>(commands.size()); }
+        const std::string& GetCommandName(uint32_t index) const { return commands[index]->name; }
+        bool RunCommand(uint32_t index);
+
+        const ScriptBatchStats& GetStats() const { return stats; }
+    };
+
+    extern ScriptBatches mainBatches;
+}
+
+#endif //SCRIPTBATCHES_H
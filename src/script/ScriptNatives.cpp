@@ -0,0 +1,56 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+// natives scripts reach through @:hlNative("builtin", ...), they resolve against the executable's own exports.
+// the script side is in script/ScriptBridge.hx
+#define HL_NAME(n) me_script_##n
+#include <hl.h>
+
+#include "scene/SceneSystem.h"
+#include "ScriptBatches.h"
+#include "TransformBridge.h"
+
+HL_PRIM void HL_NAME(script_batch_register)(vstring* name, vclosure* update) {
+    me::script::mainBatches.Register(hl_to_utf8(name->bytes), update);
+}
+
+HL_PRIM void HL_NAME(script_command_register)(vstring* name, vclosure* command) {
+    me::script::mainBatches.RegisterCommand(hl_to_utf8(name->bytes), command);
+}
+
+// scripts move the local transform, the engine carries it through the hierarchy in PreRender
+HL_PRIM int HL_NAME(script_transform_bind)(vbyte* object) {
+    auto* gameObject = reinterpret_cast<me::scene::GameObject*>(object);
+    return static_cast<int>(me::script::mainTransforms.Bind(gameObject->GetTransform().Raw()));
+}
+
+HL_PRIM void HL_NAME(script_transform_unbind)(int slot) {
+    me::script::mainTransforms.Unbind(static_cast<uint32_t>(slot));
+}
+
+HL_PRIM vbyte* HL_NAME(script_transform_positions)() {
+    return reinterpret_cast<vbyte*>(me::script::mainTransforms.GetPositions());
+}
+
+HL_PRIM vbyte* HL_NAME(script_transform_rotations)() {
+    return reinterpret_cast<vbyte*>(me::script::mainTransforms.GetRotations());
+}
+
+// the copies the frame does around the batches, for scripts that time a whole frame's worth of bridge work
+HL_PRIM void HL_NAME(script_transform_gather)() {
+    me::script::mainTransforms.Gather();
+}
+
+HL_PRIM void HL_NAME(script_transform_apply)() {
+    me::script::mainTransforms.Apply();
+}
+
+DEFINE_PRIM(_VOID, script_batch_register, _STRING _FUN(_VOID, _NO_ARG));
+DEFINE_PRIM(_VOID, script_command_register, _STRING _FUN(_VOID, _NO_ARG));
+DEFINE_PRIM(_I32, script_transform_bind, _BYTES);
+DEFINE_PRIM(_VOID, script_transform_unbind, _I32);
+DEFINE_PRIM(_BYTES, script_transform_positions, _NO_ARG);
+DEFINE_PRIM(_BYTES, script_transform_rotations, _NO_ARG);
+DEFINE_PRIM(_VOID, script_transform_gather, _NO_ARG);
+DEFINE_PRIM(_VOID, script_transform_apply, _NO_ARG);
@@ -0,0 +1,59 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "TransformBridge.h"
+
+#include <cstring>
+#include <SDL3/SDL.h>
+
+namespace me::script {
+    TransformBridge mainTransforms;
+
+    uint32_t TransformBridge::Bind(float* position, float* rotation) {
+        uint32_t slot;
+        if (freeSlots.empty()) {
+            slot = static_cast<uint32_t>(targets.size());
+            targets.emplace_back();
+            positions.resize(positions.size() + 3);
+            rotations.resize(rotations.size() + 4);
+        } else {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+
+        targets[slot] = { position, rotation };
+        std::memcpy(&positions[slot * 3], position, sizeof(float) * 3);
+        std::memcpy(&rotations[slot * 4], rotation, sizeof(float) * 4);
+        return slot;
+    }
+
+    void TransformBridge::Unbind(uint32_t slot) {
+        if (slot >= targets.size() || targets[slot].position == nullptr) return;
+        targets[slot] = {};
+        freeSlots.push_back(slot);
+    }
+
+    void TransformBridge::Gather() {
+        uint64_t start = SDL_GetTicksNS();
+        for (uint32_t slot = 0; slot < targets.size(); slot++) {
+            const Target& target = targets[slot];
+            if (target.position == nullptr) continue;
+            std::memcpy(&positions[slot * 3], target.position, sizeof(float) * 3);
+            std::memcpy(&rotations[slot * 4], target.rotation, sizeof(float) * 4);
+        }
+        stats.bound = Size();
+        stats.gatherNanoseconds = SDL_GetTicksNS() - start;
+    }
+
+    void TransformBridge::Apply() {
+        uint64_t start = SDL_GetTicksNS();
+        for (uint32_t slot = 0; slot < targets.size(); slot++) {
+            const Target& target = targets[slot];
+            if (target.position == nullptr) continue;
+            std::memcpy(target.position, &positions[slot * 3], sizeof(float) * 3);
+            std::memcpy(target.rotation, &rotations[slot * 4], sizeof(float) * 4);
+        }
+        stats.applyNanoseconds = SDL_GetTicksNS() - start;
+    }
+}
@@ -0,0 +1,61 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef TRANSFORMBRIDGE_H
+#define TRANSFORMBRIDGE_H
+
+#include <cstdint>
+#include <vector>
+
+namespace me::script {
+    struct TransformBridgeStats {
+        uint32_t bound;
+        // cpu time copying transforms into the arrays before scripts run, and back out after
+        uint64_t gatherNanoseconds;
+        uint64_t applyNanoseconds;
+    };
+
+    // positions and rotations of script driven transforms, in flat native arrays of xyz and xyzw per slot.
+    // scripts get the arrays as typed views and write into them directly, so nothing is allocated or marshalled per transform.
+    // Gather fills the arrays from the transforms before scripts run, Apply writes them back after
+    class TransformBridge {
+        private:
+        struct Target {
+            float* position;
+            float* rotation;
+        };
+
+        std::vector<float> positions;
+        std::vector<float> rotations;
+        // a free slot has no position
+        std::vector<Target> targets;
+        std::vector<uint32_t> freeSlots;
+
+        TransformBridgeStats stats = {};
+
+        public:
+        // raw is a transform's raw storage, it has to stay where it is while bound
+        template<typename Raw>
+        uint32_t Bind(Raw& raw) {
+            return Bind(reinterpret_cast<float*>(&raw.position), reinterpret_cast<float*>(&raw.rotation));
+        }
+        uint32_t Bind(float* position, float* rotation);
+        void Unbind(uint32_t slot);
+
+        void Gather();
+        void Apply();
+
+        // 3 floats per slot, only good until the next Bind
+        float* GetPositions() { return positions.data(); }
+        // 4 floats per slot, xyzw, only good until the next Bind
+        float* GetRotations() { return rotations.data(); }
+        uint32_t Size() const { return static_cast<uint32_t>(targets.size() - freeSlots.size()); }
+        const TransformBridgeStats& GetStats() const { return stats; }
+    };
+
+    // an object rather than a pointer, scripts bind while the VM starts, before the app does anything
+    extern TransformBridge mainTransforms;
+}
+
+#endif //TRANSFORMBRIDGE_H
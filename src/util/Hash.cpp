@@ -0,0 +1,45 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#include "Hash.h"
+
+#include <cstring>
+
+namespace me::util {
+    static uint64_t RotateLeft(uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    uint64_t HashBytes(const uint8_t* data, size_t size) {
+        constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+
+        // four independent lanes over 32 byte blocks, then the tail a word and a byte at a time
+        uint64_t lanes[4] = { PRIME1 + PRIME2, PRIME2, 0, 0 - PRIME1 };
+        size_t offset = 0;
+        for (; offset + 32 <= size; offset += 32) {
+            for (int lane = 0; lane < 4; lane++) {
+                uint64_t word;
+                memcpy(&word, data + offset + lane * 8, sizeof(word));
+                lanes[lane] = RotateLeft(lanes[lane] + word * PRIME2, 31) * PRIME1;
+            }
+        }
+
+        uint64_t hash = RotateLeft(lanes[0], 1) + RotateLeft(lanes[1], 7) + RotateLeft(lanes[2], 12) + RotateLeft(lanes[3], 18);
+        hash += size;
+        for (; offset + 8 <= size; offset += 8) {
+            uint64_t word;
+            memcpy(&word, data + offset, sizeof(word));
+            hash = RotateLeft(hash ^ (RotateLeft(word * PRIME2, 31) * PRIME1), 27) * PRIME1;
+        }
+        for (; offset < size; offset++) {
+            hash = RotateLeft(hash ^ (data[offset] * PRIME1), 11) * PRIME2;
+        }
+
+        hash ^= hash >> 33;
+        hash *= PRIME2;
+        hash ^= hash >> 29;
+        return hash;
+    }
+}
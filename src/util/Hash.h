@@ -0,0 +1,21 @@
+//
+// Created by ryen on 10/17/26.
+//
+
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace me::util {
+    // fast 64 bit hash, only for telling files and cache keys apart
+    uint64_t HashBytes(const uint8_t* data, size_t size);
+
+    // mixes another hash into a running one, order matters
+    inline uint64_t HashCombine(uint64_t hash, uint64_t value) {
+        return ((hash << 17) | (hash >> 47)) ^ value;
+    }
+}
+
+#endif //HASH_H